@@ -14,24 +14,135 @@
 // 
 
 #include "BS.h"
+#include "sensor.h"
+#include "sensorfield.h"
 
 Define_Module(BS);
 
 void BS::initialize()
 {
+    x = par("posX");
+    y = par("posY");
+    primary = !isVector(); // sink[k] are the extra sinks of the network
+    if (!primary) {
+        initSink();
+        return;
+    }
+    owner = this;
 
     N = getParentModule()->par("Nnodes");
+    unsigned int Nspares = getParentModule()->par("Nspares");
+    if (Nspares > N)
+        throw cRuntimeError("Nspares (%u) can't be more than Nnodes (%u)", Nspares, N);
+    deployed = N - Nspares; // the spares are deployed later (see reviveNode)
 
     double edge = getParentModule()->par("edge");
     range = sqrt(2*pow(edge,2));
 
     bitrate = par("bitrate");
+    P = getParentModule()->par("P");
+
+    centralized = getParentModule()->par("centralized");
+    annealChains = par("annealChains");
+    clustering.setup(par("clusteringThreads"), par("annealIterations"));
+
+    multiHop = getParentModule()->par("multiHop");
+    int Nsinks = getParentModule()->par("Nsinks");
+    if (Nsinks > 1 && (multiHop || getParentModule()->par("partitioned").boolValue()))
+        throw cRuntimeError("extra sinks can't be used with multiHop or on a partitioned network");
+    for(int k = 0; k < Nsinks-1; k++)
+        sinks.push_back(check_and_cast< ::BS *>(getParentModule()->getSubmodule("sink", k)));
+    if (multiHop && N > 0) {
+        // same radio as the sensors, to weight the hops of the CH tree
+        cModule *node = retrieveNode(0);
+        RadioModel radio;
+        radio.setup(node->par("Eelec"), node->par("Eamp"), node->par("Emp"), node->par("gamma"), node->par("d0"));
+        double P = getParentModule()->par("P");
+        double cell = par("routingCell");
+        if (cell <= 0) cell = edge / std::max(1.0, round(sqrt(P * N)));    // about one CH per cell
+        router.setup(N, getParentModule()->par("minX"), getParentModule()->par("minY"), edge, edge, cell, radio, x, y);
+    }
+    electionEngine = getParentModule()->par("electionEngine");
+    if (electionEngine) {
+        election.setup(N, P);
+        for(unsigned int n = 0; n < deployed; n++)
+            election.addNode(n);
+    }
+
+    aggrHopsSignal = registerSignal("aggrHops");
+    aggrLatencySignal = registerSignal("aggrLatency");
+
+    // on a partitioned network sensors may live in other processes: only talk to them by messages
+    partitioned = getParentModule()->par("partitioned");
+    // on Field_net there are no sensor modules: the field answers for all of them
+    field = getParentModule()->par("aggregated").boolValue() ? check_and_cast<SensorField *>(getParentModule()->getSubmodule("field")) : nullptr;
+    nodes.resize(N);
+    alive.setup(N);
+    inField.assign(N, false);
+    for(unsigned int n = 0; n < N; n++){
+        nodes[n] = (partitioned || field) ? nullptr : check_and_cast<Sensor *>(retrieveNode(n));
+        if (n < deployed) {
+            alive.insert(n);
+            inField[n] = true;
+        }
+    }
+
+    energyLedger = getParentModule()->par("energyLedger");
+    if (energyLedger) ledger.setup(N);
+
+    // energy-aware CH choice reads the residual energies from the index, not from the modules
+    energyRanked = false;
+    for(unsigned int n = 0; n < N && nodes[n]; n++)
+        if (nodes[n]->par("EnergyAwareCH").boolValue()) energyRanked = true;
+    if (energyRanked) {
+        energyIndex.setup(N);
+        for(unsigned int n = 0; n < deployed; n++)
+            energyIndex.insert(n, nodes[n]->getEnergy());
+    }
+
+    roundTick = getParentModule()->par("roundTick");
+    phaseBuckets = getParentModule()->par("phaseBuckets");
+    counterRNG = getParentModule()->par("counterRNG");
+    crng.setSeed(getParentModule()->par("rngSeed").intValue());
 
     startRound_e = new cMessage("start-round", START_ROUND);
     rcvdJoin_e = new cMessage("check-JOIN-or-DATA", RCVD_JOIN);
     // let BS set the restart round time for all the network
     getParentModule()->par("roundTime") = 1 + (N * propagationDelay(DATA_M_SIZE, MAX_DIST(range)));
 
+    // round-boundary checkpoints (sensor modules only)
+    checkpointRound = par("checkpointRound");
+    checkpoint_e = new cMessage("checkpoint", CHECKPOINT);
+    checkpoint_e->setSchedulingPriority(-1); // before the sensors start the round
+    firstDeadRound = -1;
+    timeOffset = 0;
+    endTime = -1;
+    r = par("round");
+    trace.setup(par("traceRecords").intValue());
+    anomalies = 0;
+    const char *restoreFile = par("restoreFile");
+    if ((checkpointRound >= 0 || restoreFile[0]) && (partitioned || field))
+        throw cRuntimeError("checkpoints need the sensor modules: they can't be used on Parallel_net or Field_net");
+    if (restoreFile[0])
+        restoreCheckpoint(restoreFile);
+    if (checkpointRound == (int) par("round") + 1)
+        scheduleAt(0, checkpoint_e);
+
+    setupMobility();
+    setupMaintenance();
+
+    // per-round state hashes, written like checkpoints before the sensors start a round
+    digest_e = new cMessage("digest", DIGEST);
+    digest_e->setSchedulingPriority(-1);
+    const char *digestFile = par("digestFile");
+    if (digestFile[0]) {
+        if (partitioned)
+            throw cRuntimeError("state digests need all the sensors in this process: they can't be used on Parallel_net");
+        if (!digest.open(digestFile, N))
+            throw cRuntimeError("can't write digest file %s", digestFile);
+        scheduleAt(0, digest_e);
+    }
+
     scheduleAt(0,startRound_e);
 
 
@@ -39,46 +150,63 @@ void BS::initialize()
 
 void BS::handleMessage(cMessage *msg)
 {
-    unsigned int Ndead = getParentModule()->par("Ndead");
-
-    if(Ndead < N)
+    if(endTime < 0) // until the network is dead (see networkDead)
     {
         switch(msg->getKind())
         {
 
             case START_ROUND:
                 // start a new round in LEACH
+                if (energyLedger) settleLedger(); // the previous round is over: pay its costs
+                if (roundTick) {
+                    // sensors don't have their own timer: start their round from here
+                    // (iterate on a copy: a node may die, and the set be compacted, meanwhile)
+                    std::vector<int> ids = alive.list();
+                    for(unsigned int i = 0; i < ids.size(); i++)
+                        if(field)
+                            field->startRound(ids[i]);
+                        else if(nodes[ids[i]]->isAlive())
+                            nodes[ids[i]]->startRound();
+                }
 
                 r = par("round"); // NOTE: par("round") starts at -1
                 r++;
                 par("round") = r;
                 if (r == 0) roundTime = getParentModule()->par("roundTime");
                 getParentModule()->par("round") = r; // let only BS node update also the net parameter
-                msgBuf.clear();
+                traceEvent(TraceRing::ROUND, -1, alive.size());
+                members.open(r);
                 cancelEvent(rcvdJoin_e);
+                for(unsigned int k = 0; k < sinks.size(); k++)
+                    sinks[k]->sinkRound(r);
                 // schedule the next round after roundTime
                 scheduleAt(simTime()+roundTime,startRound_e);
+                if (checkpointRound == (int) r+1)
+                    scheduleAt(simTime()+roundTime, checkpoint_e);
+                if (digest.isOpen())
+                    scheduleAt(simTime()+roundTime, digest_e);
+                if (centralized) centralizedSetup();
                 break;
 
             case RCVD_JOIN:
                 // wake up after timeout to check received ADVs
-                if(msgBuf.size() > 0)
+                if(members.size() > 0)
                     createTXSched();
                 break;
             case JOIN_M:
-                if (msgBuf.size() == 0)
+                if (members.size() == 0)
                 {
                     //if it's the first JOIN received, let's compute the schedule
-                    msgBuf.push_back(msg);
-                    if(!rcvdJoin_e->isScheduled())
+                    if(members.add(((mJoin *) msg)->getId(), ((mJoin *) msg)->getRound()) && !rcvdJoin_e->isScheduled())
                         scheduleAt(simTime()+EPSILON, rcvdJoin_e); //EPSILON needed for messages arrived at the same time
                 }
                 else
                 {
                     // each subsequent JOIN will be handled at the next Schedule creation
                     // (i.e. createTXSched()) in order to increase the schedule
-                    msgBuf.push_back(msg);
+                    members.add(((mJoin *) msg)->getId(), ((mJoin *) msg)->getRound());
                 }
+                cancelAndDelete(msg); // only the id is needed
                 break;
 
             case DATA_M:
@@ -86,22 +214,68 @@ void BS::handleMessage(cMessage *msg)
                 //since they are going to serve as JOIN messages to create the new schedule
                 handleData(msg);
                 break;
+
+            case RELAY_M:
+                handleRelay((mRelay *) msg);
+                break;
+
+            case SCHED_M:
+                dispatchSchedule((mScheduleTable *) msg);
+                break;
+
+            case DEAD_M:
+                handleDead((mDead *) msg);
+                break;
+
+            case PHASE_M:
+                firePhase(msg);
+                break;
+
+            case CHECKPOINT:
+                saveCheckpoint(par("checkpointFile"));
+                break;
+
+            case DIGEST:
+                writeDigest();
+                break;
+
+            case MOBILITY_STEP:
+                moveNodes();
+                break;
+
+            case MAINTENANCE:
+                maintain();
+                break;
         }
     }
+    else if (!msg->isSelfMessage())
+        delete msg; // the network is dead: nobody reads it (timers are deleted in finish)
 }
 
 void BS::handleData(cMessage *msg)
 {
     mData *DATA = (mData *) msg;
     if (r == DATA->getRound()){
-        msgBuf.push_back(msg); // insert DATA into the message buffer
-        EV << "received data from " << msg->getSenderModuleId() - 2 << "\n";
+        members.add(DATA->getId(), DATA->getRound()); // DATA senders serve as JOINs for the next schedule
+        EV << "received data from " << DATA->getId() << "\n";
     }
+    else
+        traceAnomaly(TraceRing::STALE_DATA, DATA->getId());
+    cancelAndDelete(msg);
+}
+
+void BS::handleRelay(mRelay *RELAY)
+{
+    // aggregate delivered through the CH tree
+    emit(aggrHopsSignal, RELAY->getHops());
+    emit(aggrLatencySignal, (simTime() - RELAY->getCreationTime()).dbl());
+    EV << "aggregate of CH " << RELAY->getId() << " received after " << RELAY->getHops() << " hops\n";
+    cancelAndDelete(RELAY);
 }
 
 void BS::createTXSched()
 {
-    clusterN = msgBuf.size();
+    clusterN = members.size();
 
     // in order to adjust power of transmission, first keep track of the max_distance of nodes among the ones in the cluster
     sensor_max_dist = MAX_DIST(range);
@@ -111,20 +285,25 @@ void BS::createTXSched()
     double SCHED_delay = propagationDelay(SCHED_M_SIZE, sensor_max_dist);
 
     // now send their SCHED information (i.e. their turn to transmit)
-    for(unsigned int i = 0; i < msgBuf.size(); i++){
-        mJoin *JOIN = (mJoin *) msgBuf.at(i);
-        mSchedule *SCHED = (mSchedule *) new mSchedule("schedule-info", SCHED_M);
-        SCHED->setTurn(i);
-        SCHED->setDuration(slot);
-        SCHED->setRound(par("round"));
-        SCHED->setCHId(BS_ID);
-        cModule *sensor = retrieveNode(JOIN->getId());
-        EV << "sending schedule to " << JOIN->getId() << "\n";
-        sendDirect(SCHED, SCHED_delay, 0, sensor->gate("in"));
-        cancelAndDelete(JOIN);
+    // one table for all of them, each node reads its turn by index
+    mScheduleTable *SCHED = new mScheduleTable("schedule-table", SCHED_M);
+    SCHED->setDuration(slot);
+    SCHED->setRound(par("round"));
+    SCHED->setCHId(BS_ID);
+    traceEvent(TraceRing::SCHED, BS_ID, clusterN);
+    SCHED->setMembersArraySize(members.size());
+    for(unsigned int i = 0; i < members.size(); i++)
+        SCHED->setMembers(i, members.at(i));
+    if (partitioned) {
+        // the proxies deliver one copy to each node
+        SCHED->addPar("dest") = (long) MULTICAST_ID;
+        SCHED->addPar("delay") = SCHED_delay;
+        send(SCHED, "out");
     }
+    else
+        scheduleAt(simTime()+SCHED_delay, SCHED);
 
-    msgBuf.clear(); // empty buffer
+    members.clear(); // empty buffer
 
 
 
@@ -137,16 +316,487 @@ void BS::createTXSched()
 #endif
 }
 
+void BS::dispatchSchedule(mScheduleTable *SCHED)
+{
+    // the table is on air: hand every node its turn
+    for(unsigned int i = 0; i < SCHED->getMembersArraySize(); i++){
+        int member = SCHED->getMembers(i);
+        if(owner->isAlive(member)){ // don't send to nodes died in the meantime
+            EV << "schedule reaches " << member << "\n";
+            if(field)
+                field->receiveSchedule(member, SCHED, i);
+            else
+                nodes[member]->receiveSchedule(SCHED, i);
+        }
+    }
+    cancelAndDelete(SCHED);
+}
+
+void BS::centralizedSetup()
+{
+    // collect position and residual energy of alive nodes
+    snapshot.clear();
+    const std::vector<int> &ids = alive.list();
+    for(unsigned int i = 0; i < ids.size(); i++){
+        Sensor *sensor = nodes[ids[i]];
+        snapshot.add(ids[i], sensor->getX(), sensor->getY(), sensor->getEnergy());
+    }
+
+    unsigned int alive = snapshot.size();
+    unsigned int k = (unsigned int) round(P * alive);
+    if (P > 0 && k == 0 && alive > 0) k = 1;
+
+    // one seed per annealing chain, drawn in a fixed order from the module RNG
+    std::vector<uint32_t> seeds(annealChains);
+    for(unsigned int c = 0; c < annealChains; c++)
+        seeds[c] = counterRNG ? (crng.bits32(c, r, CounterRNG::CLUSTERING) & 0x7fffffff) : intuniform(0, 0x7fffffff);
+
+    std::vector<int> head;
+    double cost = clustering.run(snapshot, k, seeds, head);
+    EV << "LEACH-C: " << k << " CHs among " << alive << " nodes, cost " << cost << "\n";
+
+    // TDMA turns follow the node id order inside each cluster; nodes without CH send to the BS
+    std::vector<int> turn(alive, 0);
+    std::vector<int> members(alive, 0);
+    unsigned int orphans = 0;
+    for(unsigned int i = 0; i < alive; i++){
+        if(head[i] < 0)
+            turn[i] = orphans++;
+        else if(head[i] != (int) i)
+            turn[i] = members[head[i]]++;
+    }
+
+    double slot = propagationDelay(DATA_M_SIZE, MAX_DIST(range));
+    double ASSIGN_delay = propagationDelay(ASSIGN_M_SIZE, MAX_DIST(range));
+
+    for(unsigned int i = 0; i < alive; i++){
+        mAssign *ASSIGN = new mAssign("cluster-assignment", ASSIGN_M);
+        ASSIGN->setRound(r);
+        ASSIGN->setCHId((head[i] < 0) ? BS_ID : snapshot.id[head[i]]);
+        ASSIGN->setTurn(turn[i]);
+        ASSIGN->setDuration(slot);
+        ASSIGN->setClusterN(members[i]);
+        sendDirect(ASSIGN, ASSIGN_delay, 0, nodes[snapshot.id[i]]->gate("in"));
+    }
+}
+
+bool BS::isElected(unsigned int r, int id)
+{
+    // the first node asking in a round triggers the election of the whole network
+    unsigned int k = 0;
+    election.elect(r, [this, r, &k]() { return counterRNG ? crng.uniform01(k++, r, CounterRNG::ELECTION_ENGINE) : uniform(0, 1); }, alive.list());
+    return election.isElected(id);
+}
+
+void BS::handleDead(mDead *DEAD)
+{
+    // partitioned network: sensors can't update Ndead themselves
+    bool first = nodeDied(DEAD->getId());
+    unsigned int Ndead = getParentModule()->par("Ndead");
+    getParentModule()->par("Ndead") = Ndead+1;
+    if (first) recordScalar("firstNodeDead", DEAD->getRound());
+    cancelAndDelete(DEAD);
+    if (Ndead+1 == deployed) networkDead(); // stop simulation if all nodes are dead
+}
+
+void BS::schedulePhase(simtime_t t, short kind, int id)
+{
+    // called by the sensors, also from their initialize()
+    Enter_Method_Silent();
+    if (phases.schedule(t.raw(), kind, id)) {
+        // first timer of this phase at time t: one wake-up for all of them
+        cMessage *wake = new cMessage("phase-bucket", PHASE_M);
+        wake->addPar("phase") = (long) kind;
+        scheduleAt(t, wake);
+    }
+}
+
+void BS::cancelPhase(short kind, int id)
+{
+    Enter_Method_Silent();
+    phases.cancel(kind, id);
+}
+
+void BS::firePhase(cMessage *msg)
+{
+    short kind = msg->par("phase").longValue();
+    std::vector<int> ids;
+    phases.take(simTime().raw(), kind, ids);
+    for(unsigned int i = 0; i < ids.size(); i++)
+        nodes[ids[i]]->fireTimer(kind);
+    cancelAndDelete(msg);
+}
+
+void BS::settleLedger()
+{
+    // one pass over the nodes that owe energy
+    Enter_Method_Silent();
+    std::vector<int> ids;
+    ledger.takeDebtors(ids);
+    for(unsigned int i = 0; i < ids.size(); i++)
+        if (nodes[ids[i]]) nodes[ids[i]]->settleEnergy();
+}
+
+void BS::networkDead()
+{
+    // the last node of our network died
+    Enter_Method_Silent();
+    if (maintenance.pending()) return; // some node gets a new battery later: the run goes on
+    endTime = simTime();
+    cModule *lanes = getParentModule()->getParentModule();
+    if (!lanes) {
+        endSimulation();
+        return;
+    }
+    // we are a lane of Lanes_net: the simulation goes on until all the lanes are over
+    int done = lanes->par("lanesDone");
+    lanes->par("lanesDone") = done+1;
+    if (done+1 == (int) lanes->par("Nlanes")) endSimulation();
+}
+
+void BS::initSink()
+{
+    // an extra sink only collects the uplinks of the nodes nearer to it than to the other
+    // sinks (orphans and CHs), and schedules its orphans: the rest is done by the primary BS
+    cModule *net = getParentModule();
+    owner = check_and_cast< ::BS *>(net->getSubmodule("baseStation"));
+    N = net->par("Nnodes");
+    double edge = net->par("edge");
+    range = sqrt(2*pow(edge,2));
+    bitrate = par("bitrate");
+    partitioned = false;
+    field = owner->field;
+    nodes = owner->nodes;
+    r = par("round");
+    endTime = -1; // the network is never dead for a sink: the primary ends the simulation
+    trace.setup(0);
+    mobile = false;
+    rcvdJoin_e = new cMessage("check-JOIN-or-DATA", RCVD_JOIN);
+    aggrHopsSignal = registerSignal("aggrHops");
+    aggrLatencySignal = registerSignal("aggrLatency");
+}
+
+void BS::sinkRound(unsigned int round)
+{
+    // called by the primary BS when it starts a round
+    Enter_Method_Silent();
+    r = round;
+    par("round") = r;
+    members.open(r);
+    cancelEvent(rcvdJoin_e);
+}
+
+void BS::collectSinks(cModule *net, std::vector<cModule *> &sinks)
+{
+    // the BS is sink 0
+    sinks.clear();
+    sinks.push_back(net->getSubmodule("baseStation"));
+    int Nsinks = net->par("Nsinks");
+    for(int k = 0; k < Nsinks-1; k++)
+        sinks.push_back(net->getSubmodule("sink", k));
+}
+
+int BS::nearestSink(const std::vector<cModule *> &sinks, int x, int y, double &dist)
+{
+    // the first one if tied
+    int nearest = 0;
+    for(unsigned int k = 0; k < sinks.size(); k++){
+        int sx = sinks[k]->par("posX"), sy = sinks[k]->par("posY");
+        double d = BS_DIST(x - sx, y - sy);
+        if (k == 0 || d < dist) {
+            nearest = k;
+            dist = d;
+        }
+    }
+    return nearest;
+}
+
+bool BS::nodeDied(int id)
+{
+    // returns true for the first death of the run (nodes may come back, see reviveNode)
+    Enter_Method_Silent();
+    bool first = firstDeadRound < 0;
+    if (first) firstDeadRound = getParentModule()->par("round");
+    alive.remove(id);
+    if (energyRanked) energyIndex.remove(id);
+    if (electionEngine) election.removeNode(id);
+    if (mobile) mobility.stop(id);
+    if (reviveAfter >= 0) {
+        maintenance.add((simTime() + reviveAfter).dbl(), id, -1);
+        scheduleMaintenance();
+    }
+    return first;
+}
+
 void BS::finish(){
-    recordScalar("endTime", simTime());
+    if (!primary) {
+        cancelAndDelete(rcvdJoin_e);
+        return;
+    }
+    cancelAndDelete(checkpoint_e);
+    cancelAndDelete(digest_e);
+    cancelAndDelete(mobility_e);
+    cancelAndDelete(maintenance_e);
+    digest.close();
+    recordScalar("endTime", ((endTime >= 0) ? endTime : simTime()) + timeOffset);
     recordScalar("rounds", r);
+    if (multiHop) recordScalar("routingTreeRebuilds", router.getRebuilds());
+    if (electionEngine) recordScalar("electionDraws", election.getDraws());
+    if (phaseBuckets) recordScalar("coalescedTimers", phases.getCoalesced());
+    if (energyLedger) recordScalar("deferredDrains", ledger.getDeferred());
+    if (maintenance.getDone() > 0) recordScalar("newBatteries", maintenance.getDone());
+    if (trace.isEnabled()) {
+        recordScalar("traceAnomalies", anomalies);
+        if (par("traceAtEnd")) dumpTrace(par("traceFile"));
+    }
+}
+
+void BS::traceAnomaly(int what, int node)
+{
+    Enter_Method_Silent();
+    if (!trace.isEnabled()) return;
+    trace.record(simTime().raw(), TraceRing::ANOMALY, r, node, what);
+    if (anomalies++ > 0) return;
+    // keep what led to the first one: later events would push it out of the ring
+    std::string file = par("traceFile").stdstringValue() + ".anomaly";
+    EV_WARN << "trace anomaly " << what << " at node " << node << ", trace dumped to " << file << "\n";
+    dumpTrace(file.c_str());
+}
+
+void BS::setupMobility()
+{
+    cModule *net = getParentModule();
+    const char *model = net->par("mobility");
+    mobile = strcmp(model, "none") != 0;
+    mobility_e = new cMessage("mobility-step", MOBILITY_STEP);
+    if (!mobile) return;
+    if (partitioned)
+        throw cRuntimeError("mobility needs all the sensors in this process: it can't be used on a partitioned network");
+
+    double edge = net->par("edge");
+    mobility.setup(N, net->par("minX"), net->par("minY"), edge, edge);
+    if (!strcmp(model, "waypoint")) {
+        double minSpeed = net->par("minSpeed"), maxSpeed = net->par("maxSpeed");
+        if (minSpeed <= 0 || maxSpeed < minSpeed)
+            throw cRuntimeError("random waypoint needs 0 < minSpeed <= maxSpeed");
+        mobility.setWaypoint(minSpeed, maxSpeed, net->par("pauseTime"));
+    }
+    else if (!strcmp(model, "trace")) {
+        const char *file = net->par("mobilityTrace");
+        if (!mobility.loadTrace(file))
+            throw cRuntimeError("can't read mobility trace %s", file);
+    }
+    else
+        throw cRuntimeError("unknown mobility model \"%s\" (none, waypoint or trace)", model);
+
+    // the nodes leave from where they were placed
+    for(unsigned int n = 0; n < N; n++)
+        if (alive.contains(n))
+            mobility.place(n, field ? field->getX(n) : nodes[n]->getX(), field ? field->getY(n) : nodes[n]->getY());
+    scheduleAt(net->par("mobilityStep").doubleValue(), mobility_e);
+}
+
+void BS::moveNodes()
+{
+    // only the nodes whose (integer) position changed are updated, with the structures that depend on it
+    std::vector<int> moved;
+    mobility.advance(simTime().dbl(), [this](int n, unsigned int k) {
+        return counterRNG ? crng.uniform01(n, k, CounterRNG::MOBILITY) : uniform(0, 1);
+    }, moved);
+    for(unsigned int i = 0; i < moved.size(); i++){
+        int n = moved[i], x = mobility.getX(n), y = mobility.getY(n);
+        if (field)
+            field->moveTo(n, x, y);
+        else
+            nodes[n]->moveTo(x, y);
+        if (multiHop) router.moveCH(n, x, y); // only if it's a CH
+    }
+    scheduleAt(simTime() + getParentModule()->par("mobilityStep").doubleValue(), mobility_e);
+}
+
+void BS::setupMaintenance()
+{
+    cModule *net = getParentModule();
+    const char *file = net->par("maintenanceFile");
+    reviveAfter = net->par("reviveAfter").doubleValue();
+    maintenance_e = new cMessage("maintenance", MAINTENANCE);
+    maintenance_e->setSchedulingPriority(-1); // a node back at a round boundary takes part in that round
+    if (!file[0] && reviveAfter < 0 && deployed == N) return;
+    if (partitioned)
+        throw cRuntimeError("maintenance needs all the sensors in this process: it can't be used on a partitioned network");
+    if (checkpointRound >= 0 || par("restoreFile").stringValue()[0])
+        throw cRuntimeError("checkpoints don't keep the spares and the maintenance to come: they can't be used with maintenance");
+    if (file[0] && !maintenance.load(file, N))
+        throw cRuntimeError("can't read maintenance file %s", file);
+    if (deployed == 0 && !maintenance.pending())
+        throw cRuntimeError("all the nodes are spares (Nspares = Nnodes) and no maintenance action deploys them");
+    scheduleMaintenance();
+}
+
+void BS::scheduleMaintenance()
+{
+    // one event, at the first action to come (actions in the past are done now)
+    if (!maintenance.pending()) return;
+    simtime_t t = std::max(simTime(), SimTime(maintenance.next()));
+    if (maintenance_e->isScheduled()) {
+        if (maintenance_e->getArrivalTime() <= t) return;
+        cancelEvent(maintenance_e);
+    }
+    scheduleAt(t, maintenance_e);
+}
+
+void BS::maintain()
+{
+    while (maintenance.pending() && SimTime(maintenance.next()) <= simTime()) {
+        MaintenancePlan::Action action = maintenance.pop();
+        reviveNode(action.node, action.energy);
+    }
+    scheduleMaintenance();
+}
+
+void BS::reviveNode(int id, double energy)
+{
+    // a new battery for node id: only the structures of this node are updated, in O(log N) at most
+    bool back = !alive.contains(id);
+    if (back) {
+        if (inField[id]) {
+            unsigned int Ndead = getParentModule()->par("Ndead");
+            getParentModule()->par("Ndead") = Ndead-1;
+        }
+        else {
+            inField[id] = true; // a spare arrives
+            deployed++;
+        }
+        alive.insert(id);
+        // it sits out the current epoch (see Sensor::revive): the refill of the next one brings it in
+        if (electionEngine) election.addNode(id, false);
+    }
+    // back nodes start with the next round
+    int round = par("round");
+    simtime_t start = startRound_e->isScheduled() ? startRound_e->getArrivalTime() : simTime();
+    if (field)
+        field->revive(id, energy, round, start);
+    else
+        nodes[id]->revive(energy, round, start);
+    if (energyRanked) energyIndex.update(id, nodes[id]->getEnergy());
+    if (mobile && back)
+        mobility.place(id, field ? field->getX(id) : nodes[id]->getX(), field ? field->getY(id) : nodes[id]->getY(), simTime().dbl());
+    traceEvent(TraceRing::BATTERY, id, back ? 1 : 0);
+}
+
+void BS::writeDigest()
+{
+    // state at the start of round r+1: the sensors haven't started it yet
+    if (energyLedger) settleLedger();
+    unsigned int heads = 0;
+    for(unsigned int n = 0; n < N; n++){
+        if(field ? !field->isAlive(n) : !nodes[n]->isAlive())
+            digest.setDead(n);
+        else {
+            int role = field ? field->getRole(n) : nodes[n]->getRole();
+            if (role == CH) heads++;
+            if(field)
+                digest.setNode(n, field->getEnergy(n), role, field->getCH(n));
+            else
+                digest.setNode(n, nodes[n]->getEnergy(), role, nodes[n]->getCH());
+        }
+    }
+    if (!digest.write((int) r + 1, getParentModule()->par("Ndead").intValue(), heads))
+        throw cRuntimeError("can't write digest file %s", par("digestFile").stringValue());
+}
+
+void BS::dumpTrace(const char *file)
+{
+    if (!trace.dump(file, SimTime::getScaleExp()))
+        throw cRuntimeError("can't write trace file %s", file);
+}
+
+/********* Checkpoints ************/
+void BS::collectRNGs(std::vector<cRNG *> &rngs)
+{
+    // the RNGs used by the modules, each once, in module order
+    for(unsigned int n = 0; n <= N; n++){
+        cRNG *rng = (n < N) ? nodes[n]->getRNG(0) : getRNG(0);
+        if (std::find(rngs.begin(), rngs.end(), rng) == rngs.end())
+            rngs.push_back(rng);
+    }
+}
+
+void BS::saveCheckpoint(const char *file)
+{
+    // all the rounds up to r are over, and no sensor started the next one
+    if (energyLedger) settleLedger();
+    Checkpoint ck;
+    ck.round = r;
+    ck.time = (simTime() + timeOffset).raw();
+    ck.Ndead = getParentModule()->par("Ndead");
+    ck.firstNodeDead = firstDeadRound;
+
+    std::vector<cRNG *> rngs;
+    collectRNGs(rngs);
+    for(unsigned int i = 0; i < rngs.size(); i++)
+        ck.rngDrawn.push_back(rngs[i]->getNumbersDrawn());
+
+    if (electionEngine) ck.eligible = election.getEligibleList();
+
+    ck.nodes.resize(N);
+    for(unsigned int n = 0; n < N; n++){
+        NodeCheckpoint &node = ck.nodes[n];
+        node.x = nodes[n]->getX();
+        node.y = nodes[n]->getY();
+        node.energy = nodes[n]->getEnergy();
+        node.alreadyCH = nodes[n]->getAlreadyCH();
+        node.dead = !nodes[n]->isAlive();
+    }
+
+    if (!ck.save(file))
+        throw cRuntimeError("can't write checkpoint file %s", file);
+    EV << "checkpoint of round " << r << " saved to " << file << "\n";
+}
+
+void BS::restoreCheckpoint(const char *file)
+{
+    Checkpoint ck;
+    if (!ck.load(file))
+        throw cRuntimeError("can't read checkpoint file %s", file);
+    if (ck.nodes.size() != N)
+        throw cRuntimeError("checkpoint %s has %d nodes, the network %d", file, (int) ck.nodes.size(), N);
+
+    for(unsigned int n = 0; n < N; n++){
+        nodes[n]->restore(ck.nodes[n], ck.round);
+        if (energyRanked) energyIndex.update(n, ck.nodes[n].energy);
+        if (ck.nodes[n].dead) nodeDied(n);
+    }
+    if (electionEngine) election.setEligible(ck.eligible);
+
+    r = ck.round;
+    par("round") = r;
+    getParentModule()->par("round") = r;
+    getParentModule()->par("Ndead") = ck.Ndead;
+    roundTime = getParentModule()->par("roundTime");
+    firstDeadRound = ck.firstNodeDead;
+    if (firstDeadRound >= 0) recordScalar("firstNodeDead", firstDeadRound);
+    timeOffset = SimTime::fromRaw(ck.time);
+
+    // bring the RNGs to the same state by drawing the numbers of the first rounds again
+    std::vector<cRNG *> rngs;
+    collectRNGs(rngs);
+    if (rngs.size() != ck.rngDrawn.size())
+        throw cRuntimeError("checkpoint %s was saved with %d RNGs, the network uses %d", file, (int) ck.rngDrawn.size(), (int) rngs.size());
+    for(unsigned int i = 0; i < rngs.size(); i++){
+        if (rngs[i]->getNumbersDrawn() > ck.rngDrawn[i])
+            throw cRuntimeError("checkpoint %s: RNG %d already drew more numbers than at the checkpoint", file, i);
+        while (rngs[i]->getNumbersDrawn() < ck.rngDrawn[i])
+            rngs[i]->intRand();
+    }
+    EV << "restored from checkpoint " << file << " at the end of round " << r << "\n";
 }
 
 /********* Utilities ************/
 cModule* BS::retrieveNode(unsigned int n)
 {
    char modName[32];
-   sprintf(modName,"node[%d]", n);
+   sprintf(modName,"^.node[%d]", n); // relative: the network may be a lane of Lanes_net
    return (cModule *) getModuleByPath(modName);
 }
 
@@ -160,9 +810,9 @@ double BS::propagationDelay(unsigned int msg_size, double dist)
 }
 
 void BS::broadcast(cMessage *msg, double delay){
-    for(unsigned int n = 0; n < N; n++){
-        cModule * sensor = retrieveNode(n);
-        sendDirect(msg->dup(), delay, 0,  sensor->gate("in"));
+    const std::vector<int> &ids = alive.list();
+    for(unsigned int i = 0; i < ids.size(); i++){
+        sendDirect(msg->dup(), delay, 0,  nodes[ids[i]]->gate("in"));
     }
 }
 
@@ -18,9 +18,26 @@
 
 #include <omnetpp.h>
 #include "common.h"
+#include "clustering.h"
+#include "routing.h"
+#include "election.h"
+#include "alive.h"
+#include "inbox.h"
+#include "phases.h"
+#include "checkpoint.h"
+#include "philox.h"
+#include "energyindex.h"
+#include "ledger.h"
+#include "trace.h"
+#include "digest.h"
+#include "mobility.h"
+#include "maintenance.h"
 
 using namespace omnetpp;
 
+class Sensor;
+class SensorField;
+
 /**
  * Base Station class
  */
@@ -29,7 +46,10 @@ class BS : public cSimpleModule
   private:
 
     unsigned int N;         // nodes in the network
-    int x,y;                // coordinates of sensor (m)
+    int x,y;                // coordinates of the BS (m)
+    bool primary;           // the baseStation, that also keeps the state of the network (not one of the extra sinks)
+    ::BS *owner;            // the primary BS (itself for the primary)
+    std::vector<BS *> sinks;    // extra sinks of the network (primary only)
     double roundTime;
     unsigned int r;
     double C = LIGHTSPEED;
@@ -37,24 +57,113 @@ class BS : public cSimpleModule
     double range;        // it will be the max communication range of sensors
     unsigned int clusterN;  // used by BD to keep track of the num. of nodes in the cluster
     double sensor_max_dist; // used by CH to adjust power of transmission
+    double P;               // proportion of CH in the network
+
+    bool centralized;       // LEACH-C: the BS selects CHs and clusters every round
+    unsigned int annealChains;
+    ClusteringEngine clustering;
+    NodeSnapshot snapshot;  // alive nodes at round start
+
+    bool multiHop;          // CHs forward aggregates over a minimum-energy CH tree
+    CHRouter router;
+
+    bool electionEngine;    // CHs are drawn in O(k) by the BS instead of one draw per node
+    ElectionEngine election;
+
+    simsignal_t aggrHopsSignal;
+    simsignal_t aggrLatencySignal;
+
+    std::vector<Sensor *> nodes;   // sensor modules, resolved once
+    AliveSet alive;         // alive sensors, used by all the fan-outs
+    bool energyRanked;      // some sensor uses EnergyAwareCH: keep energyIndex up to date
+    EnergyIndex energyIndex;    // residual energy of the alive sensors
+    bool energyLedger;      // sensors defer the costs that can't kill them, settled at every round
+    EnergyLedger ledger;
 
+    bool roundTick;         // the BS starts the round of every sensor (one event per round)
+    bool partitioned;       // sensors are reached through the proxies (Parallel_net)
+    SensorField *field;     // all the sensors, when simulated by one module (Field_net)
+    bool phaseBuckets;      // sensor timers are grouped in buckets, one FES event each
+    PhaseScheduler phases;
+    bool counterRNG;        // election engine and LEACH-C seeds come from crng
+    CounterRNG crng;
     cMessage *startRound_e;
     cMessage *rcvdJoin_e;   // event used to wake up and check JOIN msgs from sensor nodes
 
+    int checkpointRound;    // save the network before this round starts (-1: never)
+    cMessage *checkpoint_e;
+    int firstDeadRound;     // round of the first death (-1: none yet)
+    simtime_t timeOffset;   // time of the checkpoint we restored from
+    simtime_t endTime;      // death of the last node (-1: not yet)
+
+    bool mobile;            // nodes move (mobility): positions are updated every mobilityStep
+    Mobility mobility;
+    cMessage *mobility_e;
+
+    unsigned int deployed;  // nodes in the field: all but the spares not arrived yet (Nspares)
+    std::vector<bool> inField;
+    MaintenancePlan maintenance;    // new batteries and arrivals to come (maintenanceFile, reviveAfter)
+    double reviveAfter;     // a dead node gets a new battery this long after its death (< 0: never)
+    cMessage *maintenance_e;
+
+    cMessage *digest_e;
+    StateDigest digest;     // per-round state hashes (digestFile)
+
+    TraceRing trace;        // last protocol events, dumped on demand or at the first anomaly
+    unsigned int anomalies;
+
 
-    std::vector<cMessage *> msgBuf;
+    MemberInbox members;    // ids of the nodes that sent JOIN (or DATA) to the BS in the current round
 
 
   protected:
     virtual void initialize();
+    virtual void initSink();
     virtual void finish();
     virtual void handleMessage(cMessage *msg);
     virtual cModule* retrieveNode(unsigned int n);
     virtual double propagationDelay(unsigned int msg_size, double dist);
     virtual void broadcast(cMessage *msg, double delay);
     virtual void createTXSched();
+    virtual void dispatchSchedule(mScheduleTable *SCHED);
+    virtual void centralizedSetup();
     virtual void handleData(cMessage *msg);
+    virtual void handleRelay(mRelay *RELAY);
+    virtual void handleDead(mDead *DEAD);
+    virtual void firePhase(cMessage *msg);
+    virtual void collectRNGs(std::vector<cRNG *> &rngs);
+    virtual void saveCheckpoint(const char *file);
+    virtual void restoreCheckpoint(const char *file);
+    virtual void dumpTrace(const char *file);
+    virtual void writeDigest();
+    virtual void setupMobility();
+    virtual void moveNodes();
+    virtual void setupMaintenance();
+    virtual void scheduleMaintenance();
+    virtual void maintain();
+    virtual void reviveNode(int id, double energy);
 
+  public:
+    virtual CHRouter *getRouter() { return &router; }
+    virtual ElectionEngine *getElection() { return &election; }
+    virtual AliveSet *getAlive() { return &alive; }
+    virtual EnergyIndex *getEnergyIndex() { return energyRanked ? &energyIndex : nullptr; }
+    virtual EnergyLedger *getLedger() { return energyLedger ? &ledger : nullptr; }
+    virtual Mobility *getMobility() { return mobile ? &mobility : nullptr; }
+    virtual void settleLedger();
+    virtual bool isAlive(int id) { return alive.contains(id); }
+    virtual Sensor *getNode(int id) { return nodes[id]; }
+    virtual bool isElected(unsigned int r, int id);
+    virtual bool nodeDied(int id);
+    virtual unsigned int getDeployed() { return deployed; }
+    virtual void networkDead();
+    virtual void sinkRound(unsigned int round);
+    static void collectSinks(cModule *net, std::vector<cModule *> &sinks);
+    static int nearestSink(const std::vector<cModule *> &sinks, int x, int y, double &dist);
+    virtual void schedulePhase(simtime_t t, short kind, int id);
+    virtual void cancelPhase(short kind, int id);
+    void traceEvent(int kind, int node, int arg) { if (trace.isEnabled()) trace.record(simTime().raw(), kind, r, node, arg); }
+    virtual void traceAnomaly(int what, int node);
 };
 
 #endif
@@ -0,0 +1,67 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <algorithm>
+#include "alive.h"
+
+AliveSet::AliveSet()
+{
+    setup(0);
+}
+
+void AliveSet::setup(unsigned int capacity)
+{
+    bits.assign((capacity + 63) / 64, 0);
+    ids.clear();
+    ids.reserve(capacity);
+    count = 0;
+    dirty = false;
+    unsorted = false;
+}
+
+void AliveSet::insert(int id)
+{
+    if (contains(id)) return;
+    if ((unsigned int) id >= bits.size()*64)
+        bits.resize(id/64 + 1, 0);
+    bits[id >> 6] |= ((uint64_t) 1) << (id & 63);
+    if (!ids.empty() && ids.back() > id) unsorted = true;
+    ids.push_back(id);
+    count++;
+}
+
+void AliveSet::remove(int id)
+{
+    if (!contains(id)) return;
+    bits[id >> 6] &= ~(((uint64_t) 1) << (id & 63));
+    count--;
+    dirty = true;
+}
+
+void AliveSet::compact()
+{
+    // drop dead ids (and duplicates of revived ones), keeping the id order
+    if (unsorted)
+        std::sort(ids.begin(), ids.end());
+    unsigned int k = 0;
+    for (unsigned int i = 0; i < ids.size(); i++) {
+        int id = ids[i];
+        if (contains(id) && (k == 0 || ids[k-1] != id))
+            ids[k++] = id;
+    }
+    ids.resize(k);
+    dirty = false;
+    unsorted = false;
+}
@@ -0,0 +1,50 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_ALIVE_H_
+#define __IMPRO_LEACH_ALIVE_H_
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Set of the alive nodes: a bitmap for O(1) membership tests and a compact
+ * array of ids (in increasing order) for iteration. Removals only clear the bit;
+ * the array is compacted at the next iteration, so iterating costs O(alive nodes).
+ */
+class AliveSet
+{
+  private:
+    std::vector<uint64_t> bits;
+    std::vector<int> ids;
+    unsigned int count;
+    bool dirty;     // ids contains dead nodes
+    bool unsorted;  // ids has been appended out of order
+
+    void compact();
+
+  public:
+    AliveSet();
+    void setup(unsigned int capacity);
+
+    void insert(int id);
+    void remove(int id);
+    bool contains(int id) const { return id >= 0 && (unsigned int) id < bits.size()*64 && ((bits[id >> 6] >> (id & 63)) & 1); }
+    unsigned int size() const { return count; }
+
+    const std::vector<int> &list() { if (dirty || unsorted) compact(); return ids; }
+};
+
+#endif
@@ -0,0 +1,96 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <cstdio>
+#include <cstring>
+#include "checkpoint.h"
+
+static const char MAGIC[8] = {'L','E','A','C','H','C','K','1'};
+
+Checkpoint::Checkpoint() : round(-1), time(0), Ndead(0), firstNodeDead(-1)
+{
+}
+
+template<typename T> static bool put(FILE *f, const T &v) { return fwrite(&v, sizeof(T), 1, f) == 1; }
+template<typename T> static bool get(FILE *f, T &v) { return fread(&v, sizeof(T), 1, f) == 1; }
+
+bool Checkpoint::save(const char *file) const
+{
+    FILE *f = fopen(file, "wb");
+    if (!f) return false;
+
+    bool ok = fwrite(MAGIC, sizeof(MAGIC), 1, f) == 1;
+    ok = ok && put(f, (int32_t) round) && put(f, time) && put(f, (uint32_t) Ndead) && put(f, (int32_t) firstNodeDead);
+
+    ok = ok && put(f, (uint32_t) rngDrawn.size());
+    for (unsigned int i = 0; ok && i < rngDrawn.size(); i++)
+        ok = put(f, rngDrawn[i]);
+
+    ok = ok && put(f, (uint32_t) eligible.size());
+    for (unsigned int i = 0; ok && i < eligible.size(); i++)
+        ok = put(f, (int32_t) eligible[i]);
+
+    ok = ok && put(f, (uint32_t) nodes.size());
+    for (unsigned int n = 0; ok && n < nodes.size(); n++) {
+        const NodeCheckpoint &node = nodes[n];
+        ok = put(f, (int32_t) node.x) && put(f, (int32_t) node.y) && put(f, node.energy)
+                && put(f, (uint8_t) node.alreadyCH) && put(f, (uint8_t) node.dead);
+    }
+
+    return (fclose(f) == 0) && ok;
+}
+
+bool Checkpoint::load(const char *file)
+{
+    FILE *f = fopen(file, "rb");
+    if (!f) return false;
+
+    char magic[sizeof(MAGIC)];
+    int32_t r, firstDead, v32;
+    uint32_t count, dead;
+    bool ok = fread(magic, sizeof(magic), 1, f) == 1 && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+    ok = ok && get(f, r) && get(f, time) && get(f, dead) && get(f, firstDead);
+    round = r;
+    Ndead = dead;
+    firstNodeDead = firstDead;
+
+    ok = ok && get(f, count);
+    rngDrawn.assign(ok ? count : 0, 0);
+    for (unsigned int i = 0; ok && i < rngDrawn.size(); i++)
+        ok = get(f, rngDrawn[i]);
+
+    ok = ok && get(f, count);
+    eligible.assign(ok ? count : 0, 0);
+    for (unsigned int i = 0; ok && i < eligible.size(); i++) {
+        ok = get(f, v32);
+        eligible[i] = v32;
+    }
+
+    ok = ok && get(f, count);
+    nodes.resize(ok ? count : 0);
+    for (unsigned int n = 0; ok && n < nodes.size(); n++) {
+        int32_t x, y;
+        uint8_t alreadyCH, isDead;
+        ok = get(f, x) && get(f, y) && get(f, nodes[n].energy) && get(f, alreadyCH) && get(f, isDead);
+        nodes[n].x = x;
+        nodes[n].y = y;
+        nodes[n].alreadyCH = alreadyCH;
+        nodes[n].dead = isDead;
+    }
+
+    fclose(f);
+    return ok;
+}
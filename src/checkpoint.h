@@ -0,0 +1,58 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_CHECKPOINT_H_
+#define __IMPRO_LEACH_CHECKPOINT_H_
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * State of a sensor at a round boundary. The rest of the node state
+ * (CH, cluster, timers) is reset at the start of every round.
+ */
+struct NodeCheckpoint
+{
+    int x, y;
+    double energy;
+    bool alreadyCH;     // has been CH in the current epoch
+    bool dead;
+};
+
+/**
+ * Snapshot of the network taken at the boundary between two rounds, to
+ * continue a run from there (possibly with other parameters).
+ * Stored as a binary file: a header, the counters, then one record per node.
+ */
+class Checkpoint
+{
+  public:
+    int round;                  // last completed round
+    int64_t time;               // simulation time of the boundary (raw)
+    unsigned int Ndead;
+    int firstNodeDead;          // round of the first death (-1: none yet)
+    std::vector<uint64_t> rngDrawn;     // numbers drawn from each RNG, in module order
+    std::vector<int> eligible;  // election engine: eligible nodes, in their order
+    std::vector<NodeCheckpoint> nodes;
+
+    Checkpoint();
+
+    /** Both return false if the file can't be written/read, or is not a checkpoint. */
+    bool save(const char *file) const;
+    bool load(const char *file);
+};
+
+#endif
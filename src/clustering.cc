@@ -0,0 +1,187 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include "clustering.h"
+
+void NodeSnapshot::clear()
+{
+    id.clear();
+    x.clear();
+    y.clear();
+    energy.clear();
+}
+
+void NodeSnapshot::add(int id, double x, double y, double energy)
+{
+    this->id.push_back(id);
+    this->x.push_back(x);
+    this->y.push_back(y);
+    this->energy.push_back(energy);
+}
+
+ClusteringEngine::ClusteringEngine()
+{
+    setup(0, 500);
+}
+
+void ClusteringEngine::setup(unsigned int threads, unsigned int iterations)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    this->threads = std::max(1u, threads);
+    this->iterations = iterations;
+}
+
+// sum of squared distances between each node and its closest CH
+double ClusteringEngine::cost(const NodeSnapshot &s, const std::vector<unsigned int> &heads) const
+{
+    const unsigned int n = s.size();
+    const unsigned int k = heads.size();
+    std::vector<double> hx(k), hy(k);
+    for (unsigned int j = 0; j < k; j++) {
+        hx[j] = s.x[heads[j]];
+        hy[j] = s.y[heads[j]];
+    }
+
+    double sum = 0;
+    for (unsigned int i = 0; i < n; i++) {
+        double best = std::numeric_limits<double>::infinity();
+        for (unsigned int j = 0; j < k; j++) {
+            double dx = s.x[i] - hx[j];
+            double dy = s.y[i] - hy[j];
+            double d2 = dx*dx + dy*dy;
+            if (d2 < best) best = d2;
+        }
+        sum += best;
+    }
+    return sum;
+}
+
+void ClusteringEngine::anneal(const NodeSnapshot &s, const std::vector<unsigned int> &eligible, unsigned int k, Chain &c) const
+{
+    std::mt19937 rng(c.seed);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+
+    // initial configuration: k distinct eligible nodes (partial Fisher-Yates)
+    std::vector<unsigned int> pool(eligible);
+    for (unsigned int j = 0; j < k; j++) {
+        std::uniform_int_distribution<unsigned int> pick(j, pool.size() - 1);
+        std::swap(pool[j], pool[pick(rng)]);
+    }
+    // pool[0..k) are the CHs, pool[k..) the candidates for a swap
+    std::vector<unsigned int> current(pool.begin(), pool.begin() + k);
+    double currentCost = cost(s, current);
+
+    c.heads = current;
+    c.cost = currentCost;
+
+    if (pool.size() == k)
+        return; // every eligible node is already CH
+
+    double T0 = currentCost / s.size();    // initial temperature: mean squared distance
+    std::uniform_int_distribution<unsigned int> pickHead(0, k - 1);
+    std::uniform_int_distribution<unsigned int> pickCand(k, pool.size() - 1);
+
+    for (unsigned int it = 0; it < iterations; it++) {
+        double T = T0 * (1.0 - ((double) it) / iterations);
+        unsigned int h = pickHead(rng);
+        unsigned int cand = pickCand(rng);
+
+        std::swap(current[h], pool[cand]);
+        double newCost = cost(s, current);
+        double delta = newCost - currentCost;
+
+        if (delta <= 0 || (T > 0 && U(rng) < exp(-delta / T))) {
+            currentCost = newCost;
+            if (currentCost < c.cost) {
+                c.cost = currentCost;
+                c.heads = current;
+            }
+        } else {
+            std::swap(current[h], pool[cand]); // reject the move
+        }
+    }
+}
+
+double ClusteringEngine::run(const NodeSnapshot &s, unsigned int k, const std::vector<uint32_t> &seeds, std::vector<int> &head) const
+{
+    const unsigned int n = s.size();
+    head.assign(n, -1);
+    if (n == 0 || k == 0 || seeds.empty())
+        return 0;
+
+    // only nodes above the average energy can be CH
+    double avg = 0;
+    for (unsigned int i = 0; i < n; i++)
+        avg += s.energy[i];
+    avg /= n;
+
+    std::vector<unsigned int> eligible;
+    for (unsigned int i = 0; i < n; i++)
+        if (s.energy[i] >= avg) eligible.push_back(i);
+
+    k = std::min(k, (unsigned int) eligible.size());
+    if (k == 0)
+        return 0;
+
+    std::vector<Chain> chains(seeds.size());
+    for (unsigned int c = 0; c < chains.size(); c++)
+        chains[c].seed = seeds[c];
+
+    // chains are statically distributed over the worker threads
+    unsigned int workers = std::min(threads, (unsigned int) chains.size());
+    if (workers <= 1) {
+        for (unsigned int c = 0; c < chains.size(); c++)
+            anneal(s, eligible, k, chains[c]);
+    } else {
+        std::vector<std::thread> pool;
+        for (unsigned int w = 0; w < workers; w++) {
+            pool.push_back(std::thread([&, w]() {
+                for (unsigned int c = w; c < chains.size(); c += workers)
+                    anneal(s, eligible, k, chains[c]);
+            }));
+        }
+        for (unsigned int w = 0; w < workers; w++)
+            pool[w].join();
+    }
+
+    unsigned int best = 0;
+    for (unsigned int c = 1; c < chains.size(); c++)
+        if (chains[c].cost < chains[best].cost) best = c;
+
+    // final assignment: every node joins its closest CH
+    const std::vector<unsigned int> &heads = chains[best].heads;
+    for (unsigned int i = 0; i < n; i++) {
+        double bestDist = std::numeric_limits<double>::infinity();
+        for (unsigned int j = 0; j < heads.size(); j++) {
+            double dx = s.x[i] - s.x[heads[j]];
+            double dy = s.y[i] - s.y[heads[j]];
+            double d2 = dx*dx + dy*dy;
+            if (d2 < bestDist) {
+                bestDist = d2;
+                head[i] = heads[j];
+            }
+        }
+    }
+    for (unsigned int j = 0; j < heads.size(); j++)
+        head[heads[j]] = heads[j];
+
+    return chains[best].cost;
+}
@@ -0,0 +1,71 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_CLUSTERING_H_
+#define __IMPRO_LEACH_CLUSTERING_H_
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Snapshot of the alive nodes taken by the BS at round start (structure of arrays)
+ */
+struct NodeSnapshot
+{
+    std::vector<int> id;
+    std::vector<double> x, y;
+    std::vector<double> energy;
+
+    void clear();
+    void add(int id, double x, double y, double energy);
+    unsigned int size() const { return id.size(); }
+};
+
+/**
+ * Centralized (LEACH-C) cluster formation.
+ * Only nodes with at least the average energy can be CH. The CH set minimizing the sum of
+ * squared distances between nodes and their closest CH is searched by simulated annealing.
+ * Several independent chains run on separate threads over the same (read-only) snapshot;
+ * the best one wins, ties going to the lowest chain, so the result does not depend on the
+ * number of threads.
+ */
+class ClusteringEngine
+{
+  private:
+    unsigned int threads;       // worker threads (0: hardware concurrency)
+    unsigned int iterations;    // annealing steps per chain
+
+    struct Chain {
+        uint32_t seed;
+        std::vector<unsigned int> heads;  // snapshot indexes of the CHs
+        double cost;
+    };
+
+    double cost(const NodeSnapshot &s, const std::vector<unsigned int> &heads) const;
+    void anneal(const NodeSnapshot &s, const std::vector<unsigned int> &eligible, unsigned int k, Chain &c) const;
+
+  public:
+    ClusteringEngine();
+    void setup(unsigned int threads, unsigned int iterations);
+
+    /**
+     * Select k CHs among the nodes of the snapshot, running one annealing chain per seed.
+     * head[i] is set to the snapshot index of the CH of node i (i itself for a CH), or -1
+     * if no CH could be selected. Returns the cost of the chosen configuration.
+     */
+    double run(const NodeSnapshot &s, unsigned int k, const std::vector<uint32_t> &seeds, std::vector<int> &head) const;
+};
+
+#endif
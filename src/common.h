@@ -17,6 +17,7 @@
 #define JOIN_M_SIZE 128 // size of JOIN message (bit)
 #define SCHED_M_SIZE 128+64 // size of
 #define DATA_M_SIZE 2000 // size of DATA message (bit)
+#define ASSIGN_M_SIZE 128+64 // size of ASSIGN message (bit)
 #define COMP_FACTOR 10.0
 
 #define MAX_DIST(range) (range)
@@ -29,6 +30,8 @@
 #define ONE_TX_PER_ROUND
 
 #define BS_ID 999999
+#define BROADCAST_ID -1 // all the sensors (partitioned network only)
+#define MULTICAST_ID -2 // the members of a TDMA table (partitioned network only)
 
 
 enum msgKinds {
@@ -45,7 +48,23 @@ enum msgKinds {
     RCVD_SCHED,
     RCVD_DATA,
     // new events
-    CENTER_M
+    CENTER_M,
+    // centralized clustering (LEACH-C)
+    ASSIGN_M,
+    // multi-hop inter-CH routing
+    RELAY_M,
+    // partitioned network: death notice to the BS
+    DEAD_M,
+    // a bucket of sensor timers expired (phaseBuckets)
+    PHASE_M,
+    // round boundary: snapshot of the network (checkpointRound)
+    CHECKPOINT,
+    // round boundary: hash of the network state (digestFile)
+    DIGEST,
+    // the nodes move (mobility)
+    MOBILITY_STEP,
+    // a node gets a new battery, or is deployed (maintenance)
+    MAINTENANCE
 };
 
 enum compState {
@@ -60,6 +79,12 @@ enum nodeRole {
     DEAD
 };
 
+// partition of a node in a Parallel_net (contiguous blocks of ids, the BS is in the first one)
+inline unsigned int partitionOf(int id, unsigned int N, unsigned int Np)
+{
+    return (id == BS_ID) ? 0 : (unsigned int) (((unsigned long long) id * Np) / N);
+}
+
 
 
 #endif /* COMMON_H_ */
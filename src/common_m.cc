@@ -182,6 +182,8 @@ Register_Class(mAdvertisement)
 mAdvertisement::mAdvertisement(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
 {
     this->id = 0;
+    this->x = 0;
+    this->y = 0;
 }
 
 mAdvertisement::mAdvertisement(const mAdvertisement& other) : ::omnetpp::cMessage(other)
@@ -204,18 +206,24 @@ mAdvertisement& mAdvertisement::operator=(const mAdvertisement& other)
 void mAdvertisement::copy(const mAdvertisement& other)
 {
     this->id = other.id;
+    this->x = other.x;
+    this->y = other.y;
 }
 
 void mAdvertisement::parsimPack(omnetpp::cCommBuffer *b) const
 {
     ::omnetpp::cMessage::parsimPack(b);
     doParsimPacking(b,this->id);
+    doParsimPacking(b,this->x);
+    doParsimPacking(b,this->y);
 }
 
 void mAdvertisement::parsimUnpack(omnetpp::cCommBuffer *b)
 {
     ::omnetpp::cMessage::parsimUnpack(b);
     doParsimUnpacking(b,this->id);
+    doParsimUnpacking(b,this->x);
+    doParsimUnpacking(b,this->y);
 }
 
 unsigned int mAdvertisement::getId() const
@@ -228,6 +236,26 @@ void mAdvertisement::setId(unsigned int id)
     this->id = id;
 }
 
+int mAdvertisement::getX() const
+{
+    return this->x;
+}
+
+void mAdvertisement::setX(int x)
+{
+    this->x = x;
+}
+
+int mAdvertisement::getY() const
+{
+    return this->y;
+}
+
+void mAdvertisement::setY(int y)
+{
+    this->y = y;
+}
+
 class mAdvertisementDescriptor : public omnetpp::cClassDescriptor
 {
   private:
@@ -293,7 +321,7 @@ const char *mAdvertisementDescriptor::getProperty(const char *propertyname) cons
 int mAdvertisementDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
-    return basedesc ? 1+basedesc->getFieldCount() : 1;
+    return basedesc ? 3+basedesc->getFieldCount() : 3;
 }
 
 unsigned int mAdvertisementDescriptor::getFieldTypeFlags(int field) const
@@ -306,8 +334,10 @@ unsigned int mAdvertisementDescriptor::getFieldTypeFlags(int field) const
     }
     static unsigned int fieldTypeFlags[] = {
         FD_ISEDITABLE,
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
     };
-    return (field>=0 && field<1) ? fieldTypeFlags[field] : 0;
+    return (field>=0 && field<3) ? fieldTypeFlags[field] : 0;
 }
 
 const char *mAdvertisementDescriptor::getFieldName(int field) const
@@ -320,8 +350,10 @@ const char *mAdvertisementDescriptor::getFieldName(int field) const
     }
     static const char *fieldNames[] = {
         "id",
+        "x",
+        "y",
     };
-    return (field>=0 && field<1) ? fieldNames[field] : nullptr;
+    return (field>=0 && field<3) ? fieldNames[field] : nullptr;
 }
 
 int mAdvertisementDescriptor::findField(const char *fieldName) const
@@ -329,6 +361,8 @@ int mAdvertisementDescriptor::findField(const char *fieldName) const
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     int base = basedesc ? basedesc->getFieldCount() : 0;
     if (fieldName[0]=='i' && strcmp(fieldName, "id")==0) return base+0;
+    if (fieldName[0]=='x' && strcmp(fieldName, "x")==0) return base+1;
+    if (fieldName[0]=='y' && strcmp(fieldName, "y")==0) return base+2;
     return basedesc ? basedesc->findField(fieldName) : -1;
 }
 
@@ -342,8 +376,10 @@ const char *mAdvertisementDescriptor::getFieldTypeString(int field) const
     }
     static const char *fieldTypeStrings[] = {
         "unsigned int",
+        "int",
+        "int",
     };
-    return (field>=0 && field<1) ? fieldTypeStrings[field] : nullptr;
+    return (field>=0 && field<3) ? fieldTypeStrings[field] : nullptr;
 }
 
 const char **mAdvertisementDescriptor::getFieldPropertyNames(int field) const
@@ -411,6 +447,8 @@ std::string mAdvertisementDescriptor::getFieldValueAsString(void *object, int fi
     mAdvertisement *pp = (mAdvertisement *)object; (void)pp;
     switch (field) {
         case 0: return ulong2string(pp->getId());
+        case 1: return long2string(pp->getX());
+        case 2: return long2string(pp->getY());
         default: return "";
     }
 }
@@ -426,6 +464,8 @@ bool mAdvertisementDescriptor::setFieldValueAsString(void *object, int field, in
     mAdvertisement *pp = (mAdvertisement *)object; (void)pp;
     switch (field) {
         case 0: pp->setId(string2ulong(value)); return true;
+        case 1: pp->setX(string2long(value)); return true;
+        case 2: pp->setY(string2long(value)); return true;
         default: return false;
     }
 }
@@ -762,6 +802,7 @@ Register_Class(mJoin)
 mJoin::mJoin(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
 {
     this->id = 0;
+    this->round = 0;
 }
 
 mJoin::mJoin(const mJoin& other) : ::omnetpp::cMessage(other)
@@ -784,18 +825,21 @@ mJoin& mJoin::operator=(const mJoin& other)
 void mJoin::copy(const mJoin& other)
 {
     this->id = other.id;
+    this->round = other.round;
 }
 
 void mJoin::parsimPack(omnetpp::cCommBuffer *b) const
 {
     ::omnetpp::cMessage::parsimPack(b);
     doParsimPacking(b,this->id);
+    doParsimPacking(b,this->round);
 }
 
 void mJoin::parsimUnpack(omnetpp::cCommBuffer *b)
 {
     ::omnetpp::cMessage::parsimUnpack(b);
     doParsimUnpacking(b,this->id);
+    doParsimUnpacking(b,this->round);
 }
 
 int mJoin::getId() const
@@ -808,6 +852,16 @@ void mJoin::setId(int id)
     this->id = id;
 }
 
+int mJoin::getRound() const
+{
+    return this->round;
+}
+
+void mJoin::setRound(int round)
+{
+    this->round = round;
+}
+
 class mJoinDescriptor : public omnetpp::cClassDescriptor
 {
   private:
@@ -873,7 +927,7 @@ const char *mJoinDescriptor::getProperty(const char *propertyname) const
 int mJoinDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
-    return basedesc ? 1+basedesc->getFieldCount() : 1;
+    return basedesc ? 2+basedesc->getFieldCount() : 2;
 }
 
 unsigned int mJoinDescriptor::getFieldTypeFlags(int field) const
@@ -886,8 +940,9 @@ unsigned int mJoinDescriptor::getFieldTypeFlags(int field) const
     }
     static unsigned int fieldTypeFlags[] = {
         FD_ISEDITABLE,
+        FD_ISEDITABLE,
     };
-    return (field>=0 && field<1) ? fieldTypeFlags[field] : 0;
+    return (field>=0 && field<2) ? fieldTypeFlags[field] : 0;
 }
 
 const char *mJoinDescriptor::getFieldName(int field) const
@@ -900,8 +955,9 @@ const char *mJoinDescriptor::getFieldName(int field) const
     }
     static const char *fieldNames[] = {
         "id",
+        "round",
     };
-    return (field>=0 && field<1) ? fieldNames[field] : nullptr;
+    return (field>=0 && field<2) ? fieldNames[field] : nullptr;
 }
 
 int mJoinDescriptor::findField(const char *fieldName) const
@@ -909,6 +965,7 @@ int mJoinDescriptor::findField(const char *fieldName) const
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     int base = basedesc ? basedesc->getFieldCount() : 0;
     if (fieldName[0]=='i' && strcmp(fieldName, "id")==0) return base+0;
+    if (fieldName[0]=='r' && strcmp(fieldName, "round")==0) return base+1;
     return basedesc ? basedesc->findField(fieldName) : -1;
 }
 
@@ -922,8 +979,9 @@ const char *mJoinDescriptor::getFieldTypeString(int field) const
     }
     static const char *fieldTypeStrings[] = {
         "int",
+        "int",
     };
-    return (field>=0 && field<1) ? fieldTypeStrings[field] : nullptr;
+    return (field>=0 && field<2) ? fieldTypeStrings[field] : nullptr;
 }
 
 const char **mJoinDescriptor::getFieldPropertyNames(int field) const
@@ -991,6 +1049,7 @@ std::string mJoinDescriptor::getFieldValueAsString(void *object, int field, int
     mJoin *pp = (mJoin *)object; (void)pp;
     switch (field) {
         case 0: return long2string(pp->getId());
+        case 1: return long2string(pp->getRound());
         default: return "";
     }
 }
@@ -1006,6 +1065,7 @@ bool mJoinDescriptor::setFieldValueAsString(void *object, int field, int i, cons
     mJoin *pp = (mJoin *)object; (void)pp;
     switch (field) {
         case 0: pp->setId(string2long(value)); return true;
+        case 1: pp->setRound(string2long(value)); return true;
         default: return false;
     }
 }
@@ -1037,26 +1097,28 @@ void *mJoinDescriptor::getFieldStructValuePointer(void *object, int field, int i
     }
 }
 
-Register_Class(mSchedule)
+Register_Class(mScheduleTable)
 
-mSchedule::mSchedule(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
+mScheduleTable::mScheduleTable(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
 {
-    this->turn = 0;
     this->duration = 0;
     this->round = 0;
     this->CHId = 0;
+    members_arraysize = 0;
+    this->members = 0;
 }
 
-mSchedule::mSchedule(const mSchedule& other) : ::omnetpp::cMessage(other)
+mScheduleTable::mScheduleTable(const mScheduleTable& other) : ::omnetpp::cMessage(other)
 {
     copy(other);
 }
 
-mSchedule::~mSchedule()
+mScheduleTable::~mScheduleTable()
 {
+    delete [] this->members;
 }
 
-mSchedule& mSchedule::operator=(const mSchedule& other)
+mScheduleTable& mScheduleTable::operator=(const mScheduleTable& other)
 {
     if (this==&other) return *this;
     ::omnetpp::cMessage::operator=(other);
@@ -1064,79 +1126,111 @@ mSchedule& mSchedule::operator=(const mSchedule& other)
     return *this;
 }
 
-void mSchedule::copy(const mSchedule& other)
+void mScheduleTable::copy(const mScheduleTable& other)
 {
-    this->turn = other.turn;
     this->duration = other.duration;
     this->round = other.round;
     this->CHId = other.CHId;
+    delete [] this->members;
+    this->members = (other.members_arraysize==0) ? nullptr : new int[other.members_arraysize];
+    members_arraysize = other.members_arraysize;
+    for (unsigned int i=0; i<members_arraysize; i++)
+        this->members[i] = other.members[i];
 }
 
-void mSchedule::parsimPack(omnetpp::cCommBuffer *b) const
+void mScheduleTable::parsimPack(omnetpp::cCommBuffer *b) const
 {
     ::omnetpp::cMessage::parsimPack(b);
-    doParsimPacking(b,this->turn);
     doParsimPacking(b,this->duration);
     doParsimPacking(b,this->round);
     doParsimPacking(b,this->CHId);
+    b->pack(members_arraysize);
+    doParsimArrayPacking(b,this->members,members_arraysize);
 }
 
-void mSchedule::parsimUnpack(omnetpp::cCommBuffer *b)
+void mScheduleTable::parsimUnpack(omnetpp::cCommBuffer *b)
 {
     ::omnetpp::cMessage::parsimUnpack(b);
-    doParsimUnpacking(b,this->turn);
     doParsimUnpacking(b,this->duration);
     doParsimUnpacking(b,this->round);
     doParsimUnpacking(b,this->CHId);
+    delete [] this->members;
+    b->unpack(members_arraysize);
+    if (members_arraysize==0) {
+        this->members = 0;
+    } else {
+        this->members = new int[members_arraysize];
+        doParsimArrayUnpacking(b,this->members,members_arraysize);
+    }
 }
 
-int mSchedule::getTurn() const
-{
-    return this->turn;
-}
-
-void mSchedule::setTurn(int turn)
-{
-    this->turn = turn;
-}
-
-double mSchedule::getDuration() const
+double mScheduleTable::getDuration() const
 {
     return this->duration;
 }
 
-void mSchedule::setDuration(double duration)
+void mScheduleTable::setDuration(double duration)
 {
     this->duration = duration;
 }
 
-int mSchedule::getRound() const
+int mScheduleTable::getRound() const
 {
     return this->round;
 }
 
-void mSchedule::setRound(int round)
+void mScheduleTable::setRound(int round)
 {
     this->round = round;
 }
 
-int mSchedule::getCHId() const
+int mScheduleTable::getCHId() const
 {
     return this->CHId;
 }
 
-void mSchedule::setCHId(int CHId)
+void mScheduleTable::setCHId(int CHId)
 {
     this->CHId = CHId;
 }
 
-class mScheduleDescriptor : public omnetpp::cClassDescriptor
+void mScheduleTable::setMembersArraySize(unsigned int size)
+{
+    int *members2 = (size==0) ? nullptr : new int[size];
+    unsigned int sz = members_arraysize < size ? members_arraysize : size;
+    for (unsigned int i=0; i<sz; i++)
+        members2[i] = this->members[i];
+    for (unsigned int i=sz; i<size; i++)
+        members2[i] = 0;
+    members_arraysize = size;
+    delete [] this->members;
+    this->members = members2;
+}
+
+unsigned int mScheduleTable::getMembersArraySize() const
+{
+    return members_arraysize;
+}
+
+int mScheduleTable::getMembers(unsigned int k) const
+{
+    if (k>=members_arraysize) throw omnetpp::cRuntimeError("Array of size %d indexed by %d", members_arraysize, k);
+    return this->members[k];
+}
+
+void mScheduleTable::setMembers(unsigned int k, int members)
+{
+    if (k>=members_arraysize) throw omnetpp::cRuntimeError("Array of size %d indexed by %d", members_arraysize, k);
+    this->members[k] = members;
+}
+
+class mScheduleTableDescriptor : public omnetpp::cClassDescriptor
 {
   private:
     mutable const char **propertynames;
   public:
-    mScheduleDescriptor();
-    virtual ~mScheduleDescriptor();
+    mScheduleTableDescriptor();
+    virtual ~mScheduleTableDescriptor();
 
     virtual bool doesSupport(omnetpp::cObject *obj) const override;
     virtual const char **getPropertyNames() const override;
@@ -1158,24 +1252,24 @@ class mScheduleDescriptor : public omnetpp::cClassDescriptor
     virtual void *getFieldStructValuePointer(void *object, int field, int i) const override;
 };
 
-Register_ClassDescriptor(mScheduleDescriptor)
+Register_ClassDescriptor(mScheduleTableDescriptor)
 
-mScheduleDescriptor::mScheduleDescriptor() : omnetpp::cClassDescriptor("mSchedule", "omnetpp::cMessage")
+mScheduleTableDescriptor::mScheduleTableDescriptor() : omnetpp::cClassDescriptor("mScheduleTable", "omnetpp::cMessage")
 {
     propertynames = nullptr;
 }
 
-mScheduleDescriptor::~mScheduleDescriptor()
+mScheduleTableDescriptor::~mScheduleTableDescriptor()
 {
     delete[] propertynames;
 }
 
-bool mScheduleDescriptor::doesSupport(omnetpp::cObject *obj) const
+bool mScheduleTableDescriptor::doesSupport(omnetpp::cObject *obj) const
 {
-    return dynamic_cast<mSchedule *>(obj)!=nullptr;
+    return dynamic_cast<mScheduleTable *>(obj)!=nullptr;
 }
 
-const char **mScheduleDescriptor::getPropertyNames() const
+const char **mScheduleTableDescriptor::getPropertyNames() const
 {
     if (!propertynames) {
         static const char *names[] = {  nullptr };
@@ -1186,19 +1280,19 @@ const char **mScheduleDescriptor::getPropertyNames() const
     return propertynames;
 }
 
-const char *mScheduleDescriptor::getProperty(const char *propertyname) const
+const char *mScheduleTableDescriptor::getProperty(const char *propertyname) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     return basedesc ? basedesc->getProperty(propertyname) : nullptr;
 }
 
-int mScheduleDescriptor::getFieldCount() const
+int mScheduleTableDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     return basedesc ? 4+basedesc->getFieldCount() : 4;
 }
 
-unsigned int mScheduleDescriptor::getFieldTypeFlags(int field) const
+unsigned int mScheduleTableDescriptor::getFieldTypeFlags(int field) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1210,12 +1304,12 @@ unsigned int mScheduleDescriptor::getFieldTypeFlags(int field) const
         FD_ISEDITABLE,
         FD_ISEDITABLE,
         FD_ISEDITABLE,
-        FD_ISEDITABLE,
+        FD_ISARRAY | FD_ISEDITABLE,
     };
     return (field>=0 && field<4) ? fieldTypeFlags[field] : 0;
 }
 
-const char *mScheduleDescriptor::getFieldName(int field) const
+const char *mScheduleTableDescriptor::getFieldName(int field) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1224,26 +1318,26 @@ const char *mScheduleDescriptor::getFieldName(int field) const
         field -= basedesc->getFieldCount();
     }
     static const char *fieldNames[] = {
-        "turn",
         "duration",
         "round",
         "CHId",
+        "members",
     };
     return (field>=0 && field<4) ? fieldNames[field] : nullptr;
 }
 
-int mScheduleDescriptor::findField(const char *fieldName) const
+int mScheduleTableDescriptor::findField(const char *fieldName) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     int base = basedesc ? basedesc->getFieldCount() : 0;
-    if (fieldName[0]=='t' && strcmp(fieldName, "turn")==0) return base+0;
-    if (fieldName[0]=='d' && strcmp(fieldName, "duration")==0) return base+1;
-    if (fieldName[0]=='r' && strcmp(fieldName, "round")==0) return base+2;
-    if (fieldName[0]=='C' && strcmp(fieldName, "CHId")==0) return base+3;
+    if (fieldName[0]=='d' && strcmp(fieldName, "duration")==0) return base+0;
+    if (fieldName[0]=='r' && strcmp(fieldName, "round")==0) return base+1;
+    if (fieldName[0]=='C' && strcmp(fieldName, "CHId")==0) return base+2;
+    if (fieldName[0]=='m' && strcmp(fieldName, "members")==0) return base+3;
     return basedesc ? basedesc->findField(fieldName) : -1;
 }
 
-const char *mScheduleDescriptor::getFieldTypeString(int field) const
+const char *mScheduleTableDescriptor::getFieldTypeString(int field) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1252,15 +1346,15 @@ const char *mScheduleDescriptor::getFieldTypeString(int field) const
         field -= basedesc->getFieldCount();
     }
     static const char *fieldTypeStrings[] = {
-        "int",
         "double",
         "int",
         "int",
+        "int",
     };
     return (field>=0 && field<4) ? fieldTypeStrings[field] : nullptr;
 }
 
-const char **mScheduleDescriptor::getFieldPropertyNames(int field) const
+const char **mScheduleTableDescriptor::getFieldPropertyNames(int field) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1273,7 +1367,7 @@ const char **mScheduleDescriptor::getFieldPropertyNames(int field) const
     }
 }
 
-const char *mScheduleDescriptor::getFieldProperty(int field, const char *propertyname) const
+const char *mScheduleTableDescriptor::getFieldProperty(int field, const char *propertyname) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1286,7 +1380,7 @@ const char *mScheduleDescriptor::getFieldProperty(int field, const char *propert
     }
 }
 
-int mScheduleDescriptor::getFieldArraySize(void *object, int field) const
+int mScheduleTableDescriptor::getFieldArraySize(void *object, int field) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1294,13 +1388,14 @@ int mScheduleDescriptor::getFieldArraySize(void *object, int field) const
             return basedesc->getFieldArraySize(object, field);
         field -= basedesc->getFieldCount();
     }
-    mSchedule *pp = (mSchedule *)object; (void)pp;
+    mScheduleTable *pp = (mScheduleTable *)object; (void)pp;
     switch (field) {
+        case 3: return pp->getMembersArraySize();
         default: return 0;
     }
 }
 
-const char *mScheduleDescriptor::getFieldDynamicTypeString(void *object, int field, int i) const
+const char *mScheduleTableDescriptor::getFieldDynamicTypeString(void *object, int field, int i) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1308,13 +1403,13 @@ const char *mScheduleDescriptor::getFieldDynamicTypeString(void *object, int fie
             return basedesc->getFieldDynamicTypeString(object,field,i);
         field -= basedesc->getFieldCount();
     }
-    mSchedule *pp = (mSchedule *)object; (void)pp;
+    mScheduleTable *pp = (mScheduleTable *)object; (void)pp;
     switch (field) {
         default: return nullptr;
     }
 }
 
-std::string mScheduleDescriptor::getFieldValueAsString(void *object, int field, int i) const
+std::string mScheduleTableDescriptor::getFieldValueAsString(void *object, int field, int i) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1322,17 +1417,17 @@ std::string mScheduleDescriptor::getFieldValueAsString(void *object, int field,
             return basedesc->getFieldValueAsString(object,field,i);
         field -= basedesc->getFieldCount();
     }
-    mSchedule *pp = (mSchedule *)object; (void)pp;
+    mScheduleTable *pp = (mScheduleTable *)object; (void)pp;
     switch (field) {
-        case 0: return long2string(pp->getTurn());
-        case 1: return double2string(pp->getDuration());
-        case 2: return long2string(pp->getRound());
-        case 3: return long2string(pp->getCHId());
+        case 0: return double2string(pp->getDuration());
+        case 1: return long2string(pp->getRound());
+        case 2: return long2string(pp->getCHId());
+        case 3: return long2string(pp->getMembers(i));
         default: return "";
     }
 }
 
-bool mScheduleDescriptor::setFieldValueAsString(void *object, int field, int i, const char *value) const
+bool mScheduleTableDescriptor::setFieldValueAsString(void *object, int field, int i, const char *value) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1340,17 +1435,17 @@ bool mScheduleDescriptor::setFieldValueAsString(void *object, int field, int i,
             return basedesc->setFieldValueAsString(object,field,i,value);
         field -= basedesc->getFieldCount();
     }
-    mSchedule *pp = (mSchedule *)object; (void)pp;
+    mScheduleTable *pp = (mScheduleTable *)object; (void)pp;
     switch (field) {
-        case 0: pp->setTurn(string2long(value)); return true;
-        case 1: pp->setDuration(string2double(value)); return true;
-        case 2: pp->setRound(string2long(value)); return true;
-        case 3: pp->setCHId(string2long(value)); return true;
+        case 0: pp->setDuration(string2double(value)); return true;
+        case 1: pp->setRound(string2long(value)); return true;
+        case 2: pp->setCHId(string2long(value)); return true;
+        case 3: pp->setMembers(i,string2long(value)); return true;
         default: return false;
     }
 }
 
-const char *mScheduleDescriptor::getFieldStructName(int field) const
+const char *mScheduleTableDescriptor::getFieldStructName(int field) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1363,7 +1458,7 @@ const char *mScheduleDescriptor::getFieldStructName(int field) const
     };
 }
 
-void *mScheduleDescriptor::getFieldStructValuePointer(void *object, int field, int i) const
+void *mScheduleTableDescriptor::getFieldStructValuePointer(void *object, int field, int i) const
 {
     omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
     if (basedesc) {
@@ -1371,7 +1466,7 @@ void *mScheduleDescriptor::getFieldStructValuePointer(void *object, int field, i
             return basedesc->getFieldStructValuePointer(object, field, i);
         field -= basedesc->getFieldCount();
     }
-    mSchedule *pp = (mSchedule *)object; (void)pp;
+    mScheduleTable *pp = (mScheduleTable *)object; (void)pp;
     switch (field) {
         default: return nullptr;
     }
@@ -1697,4 +1792,984 @@ void *mCenterCHDescriptor::getFieldStructValuePointer(void *object, int field, i
     }
 }
 
+Register_Class(mAssign)
+
+mAssign::mAssign(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
+{
+    this->round = 0;
+    this->CHId = 0;
+    this->turn = 0;
+    this->duration = 0;
+    this->clusterN = 0;
+}
+
+mAssign::mAssign(const mAssign& other) : ::omnetpp::cMessage(other)
+{
+    copy(other);
+}
+
+mAssign::~mAssign()
+{
+}
+
+mAssign& mAssign::operator=(const mAssign& other)
+{
+    if (this==&other) return *this;
+    ::omnetpp::cMessage::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void mAssign::copy(const mAssign& other)
+{
+    this->round = other.round;
+    this->CHId = other.CHId;
+    this->turn = other.turn;
+    this->duration = other.duration;
+    this->clusterN = other.clusterN;
+}
+
+void mAssign::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cMessage::parsimPack(b);
+    doParsimPacking(b,this->round);
+    doParsimPacking(b,this->CHId);
+    doParsimPacking(b,this->turn);
+    doParsimPacking(b,this->duration);
+    doParsimPacking(b,this->clusterN);
+}
+
+void mAssign::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cMessage::parsimUnpack(b);
+    doParsimUnpacking(b,this->round);
+    doParsimUnpacking(b,this->CHId);
+    doParsimUnpacking(b,this->turn);
+    doParsimUnpacking(b,this->duration);
+    doParsimUnpacking(b,this->clusterN);
+}
+
+int mAssign::getRound() const
+{
+    return this->round;
+}
+
+void mAssign::setRound(int round)
+{
+    this->round = round;
+}
+
+int mAssign::getCHId() const
+{
+    return this->CHId;
+}
+
+void mAssign::setCHId(int CHId)
+{
+    this->CHId = CHId;
+}
+
+int mAssign::getTurn() const
+{
+    return this->turn;
+}
+
+void mAssign::setTurn(int turn)
+{
+    this->turn = turn;
+}
+
+double mAssign::getDuration() const
+{
+    return this->duration;
+}
+
+void mAssign::setDuration(double duration)
+{
+    this->duration = duration;
+}
+
+int mAssign::getClusterN() const
+{
+    return this->clusterN;
+}
+
+void mAssign::setClusterN(int clusterN)
+{
+    this->clusterN = clusterN;
+}
+
+class mAssignDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertynames;
+  public:
+    mAssignDescriptor();
+    virtual ~mAssignDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyname) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyname) const override;
+    virtual int getFieldArraySize(void *object, int field) const override;
+
+    virtual const char *getFieldDynamicTypeString(void *object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(void *object, int field, int i) const override;
+    virtual bool setFieldValueAsString(void *object, int field, int i, const char *value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual void *getFieldStructValuePointer(void *object, int field, int i) const override;
+};
+
+Register_ClassDescriptor(mAssignDescriptor)
+
+mAssignDescriptor::mAssignDescriptor() : omnetpp::cClassDescriptor("mAssign", "omnetpp::cMessage")
+{
+    propertynames = nullptr;
+}
+
+mAssignDescriptor::~mAssignDescriptor()
+{
+    delete[] propertynames;
+}
+
+bool mAssignDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<mAssign *>(obj)!=nullptr;
+}
+
+const char **mAssignDescriptor::getPropertyNames() const
+{
+    if (!propertynames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+        const char **basenames = basedesc ? basedesc->getPropertyNames() : nullptr;
+        propertynames = mergeLists(basenames, names);
+    }
+    return propertynames;
+}
+
+const char *mAssignDescriptor::getProperty(const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? basedesc->getProperty(propertyname) : nullptr;
+}
+
+int mAssignDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? 5+basedesc->getFieldCount() : 5;
+}
+
+unsigned int mAssignDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeFlags(field);
+        field -= basedesc->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+    };
+    return (field>=0 && field<5) ? fieldTypeFlags[field] : 0;
+}
+
+const char *mAssignDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldName(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "round",
+        "CHId",
+        "turn",
+        "duration",
+        "clusterN",
+    };
+    return (field>=0 && field<5) ? fieldNames[field] : nullptr;
+}
+
+int mAssignDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    int base = basedesc ? basedesc->getFieldCount() : 0;
+    if (fieldName[0]=='r' && strcmp(fieldName, "round")==0) return base+0;
+    if (fieldName[0]=='C' && strcmp(fieldName, "CHId")==0) return base+1;
+    if (fieldName[0]=='t' && strcmp(fieldName, "turn")==0) return base+2;
+    if (fieldName[0]=='d' && strcmp(fieldName, "duration")==0) return base+3;
+    if (fieldName[0]=='c' && strcmp(fieldName, "clusterN")==0) return base+4;
+    return basedesc ? basedesc->findField(fieldName) : -1;
+}
+
+const char *mAssignDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeString(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",
+        "int",
+        "int",
+        "double",
+        "int",
+    };
+    return (field>=0 && field<5) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **mAssignDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldPropertyNames(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *mAssignDescriptor::getFieldProperty(int field, const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldProperty(field, propertyname);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int mAssignDescriptor::getFieldArraySize(void *object, int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldArraySize(object, field);
+        field -= basedesc->getFieldCount();
+    }
+    mAssign *pp = (mAssign *)object; (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+const char *mAssignDescriptor::getFieldDynamicTypeString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldDynamicTypeString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    mAssign *pp = (mAssign *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string mAssignDescriptor::getFieldValueAsString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldValueAsString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    mAssign *pp = (mAssign *)object; (void)pp;
+    switch (field) {
+        case 0: return long2string(pp->getRound());
+        case 1: return long2string(pp->getCHId());
+        case 2: return long2string(pp->getTurn());
+        case 3: return double2string(pp->getDuration());
+        case 4: return long2string(pp->getClusterN());
+        default: return "";
+    }
+}
+
+bool mAssignDescriptor::setFieldValueAsString(void *object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->setFieldValueAsString(object,field,i,value);
+        field -= basedesc->getFieldCount();
+    }
+    mAssign *pp = (mAssign *)object; (void)pp;
+    switch (field) {
+        case 0: pp->setRound(string2long(value)); return true;
+        case 1: pp->setCHId(string2long(value)); return true;
+        case 2: pp->setTurn(string2long(value)); return true;
+        case 3: pp->setDuration(string2double(value)); return true;
+        case 4: pp->setClusterN(string2long(value)); return true;
+        default: return false;
+    }
+}
+
+const char *mAssignDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructName(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+void *mAssignDescriptor::getFieldStructValuePointer(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructValuePointer(object, field, i);
+        field -= basedesc->getFieldCount();
+    }
+    mAssign *pp = (mAssign *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+Register_Class(mRelay)
+
+mRelay::mRelay(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
+{
+    this->id = 0;
+    this->round = 0;
+    this->hops = 0;
+}
+
+mRelay::mRelay(const mRelay& other) : ::omnetpp::cMessage(other)
+{
+    copy(other);
+}
+
+mRelay::~mRelay()
+{
+}
+
+mRelay& mRelay::operator=(const mRelay& other)
+{
+    if (this==&other) return *this;
+    ::omnetpp::cMessage::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void mRelay::copy(const mRelay& other)
+{
+    this->id = other.id;
+    this->round = other.round;
+    this->hops = other.hops;
+}
+
+void mRelay::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cMessage::parsimPack(b);
+    doParsimPacking(b,this->id);
+    doParsimPacking(b,this->round);
+    doParsimPacking(b,this->hops);
+}
+
+void mRelay::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cMessage::parsimUnpack(b);
+    doParsimUnpacking(b,this->id);
+    doParsimUnpacking(b,this->round);
+    doParsimUnpacking(b,this->hops);
+}
+
+int mRelay::getId() const
+{
+    return this->id;
+}
+
+void mRelay::setId(int id)
+{
+    this->id = id;
+}
+
+int mRelay::getRound() const
+{
+    return this->round;
+}
+
+void mRelay::setRound(int round)
+{
+    this->round = round;
+}
+
+int mRelay::getHops() const
+{
+    return this->hops;
+}
+
+void mRelay::setHops(int hops)
+{
+    this->hops = hops;
+}
+
+class mRelayDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertynames;
+  public:
+    mRelayDescriptor();
+    virtual ~mRelayDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyname) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyname) const override;
+    virtual int getFieldArraySize(void *object, int field) const override;
+
+    virtual const char *getFieldDynamicTypeString(void *object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(void *object, int field, int i) const override;
+    virtual bool setFieldValueAsString(void *object, int field, int i, const char *value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual void *getFieldStructValuePointer(void *object, int field, int i) const override;
+};
+
+Register_ClassDescriptor(mRelayDescriptor)
+
+mRelayDescriptor::mRelayDescriptor() : omnetpp::cClassDescriptor("mRelay", "omnetpp::cMessage")
+{
+    propertynames = nullptr;
+}
+
+mRelayDescriptor::~mRelayDescriptor()
+{
+    delete[] propertynames;
+}
+
+bool mRelayDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<mRelay *>(obj)!=nullptr;
+}
+
+const char **mRelayDescriptor::getPropertyNames() const
+{
+    if (!propertynames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+        const char **basenames = basedesc ? basedesc->getPropertyNames() : nullptr;
+        propertynames = mergeLists(basenames, names);
+    }
+    return propertynames;
+}
+
+const char *mRelayDescriptor::getProperty(const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? basedesc->getProperty(propertyname) : nullptr;
+}
+
+int mRelayDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? 3+basedesc->getFieldCount() : 3;
+}
+
+unsigned int mRelayDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeFlags(field);
+        field -= basedesc->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+    };
+    return (field>=0 && field<3) ? fieldTypeFlags[field] : 0;
+}
+
+const char *mRelayDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldName(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "id",
+        "round",
+        "hops",
+    };
+    return (field>=0 && field<3) ? fieldNames[field] : nullptr;
+}
+
+int mRelayDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    int base = basedesc ? basedesc->getFieldCount() : 0;
+    if (fieldName[0]=='i' && strcmp(fieldName, "id")==0) return base+0;
+    if (fieldName[0]=='r' && strcmp(fieldName, "round")==0) return base+1;
+    if (fieldName[0]=='h' && strcmp(fieldName, "hops")==0) return base+2;
+    return basedesc ? basedesc->findField(fieldName) : -1;
+}
+
+const char *mRelayDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeString(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",
+        "int",
+        "int",
+    };
+    return (field>=0 && field<3) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **mRelayDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldPropertyNames(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *mRelayDescriptor::getFieldProperty(int field, const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldProperty(field, propertyname);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int mRelayDescriptor::getFieldArraySize(void *object, int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldArraySize(object, field);
+        field -= basedesc->getFieldCount();
+    }
+    mRelay *pp = (mRelay *)object; (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+const char *mRelayDescriptor::getFieldDynamicTypeString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldDynamicTypeString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    mRelay *pp = (mRelay *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string mRelayDescriptor::getFieldValueAsString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldValueAsString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    mRelay *pp = (mRelay *)object; (void)pp;
+    switch (field) {
+        case 0: return long2string(pp->getId());
+        case 1: return long2string(pp->getRound());
+        case 2: return long2string(pp->getHops());
+        default: return "";
+    }
+}
+
+bool mRelayDescriptor::setFieldValueAsString(void *object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->setFieldValueAsString(object,field,i,value);
+        field -= basedesc->getFieldCount();
+    }
+    mRelay *pp = (mRelay *)object; (void)pp;
+    switch (field) {
+        case 0: pp->setId(string2long(value)); return true;
+        case 1: pp->setRound(string2long(value)); return true;
+        case 2: pp->setHops(string2long(value)); return true;
+        default: return false;
+    }
+}
+
+const char *mRelayDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructName(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+void *mRelayDescriptor::getFieldStructValuePointer(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructValuePointer(object, field, i);
+        field -= basedesc->getFieldCount();
+    }
+    mRelay *pp = (mRelay *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+Register_Class(mDead)
+
+mDead::mDead(const char *name, short kind) : ::omnetpp::cMessage(name,kind)
+{
+    this->id = 0;
+    this->round = 0;
+}
+
+mDead::mDead(const mDead& other) : ::omnetpp::cMessage(other)
+{
+    copy(other);
+}
+
+mDead::~mDead()
+{
+}
+
+mDead& mDead::operator=(const mDead& other)
+{
+    if (this==&other) return *this;
+    ::omnetpp::cMessage::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void mDead::copy(const mDead& other)
+{
+    this->id = other.id;
+    this->round = other.round;
+}
+
+void mDead::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cMessage::parsimPack(b);
+    doParsimPacking(b,this->id);
+    doParsimPacking(b,this->round);
+}
+
+void mDead::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cMessage::parsimUnpack(b);
+    doParsimUnpacking(b,this->id);
+    doParsimUnpacking(b,this->round);
+}
+
+int mDead::getId() const
+{
+    return this->id;
+}
+
+void mDead::setId(int id)
+{
+    this->id = id;
+}
+
+int mDead::getRound() const
+{
+    return this->round;
+}
+
+void mDead::setRound(int round)
+{
+    this->round = round;
+}
+
+class mDeadDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertynames;
+  public:
+    mDeadDescriptor();
+    virtual ~mDeadDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyname) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyname) const override;
+    virtual int getFieldArraySize(void *object, int field) const override;
+
+    virtual const char *getFieldDynamicTypeString(void *object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(void *object, int field, int i) const override;
+    virtual bool setFieldValueAsString(void *object, int field, int i, const char *value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual void *getFieldStructValuePointer(void *object, int field, int i) const override;
+};
+
+Register_ClassDescriptor(mDeadDescriptor)
+
+mDeadDescriptor::mDeadDescriptor() : omnetpp::cClassDescriptor("mDead", "omnetpp::cMessage")
+{
+    propertynames = nullptr;
+}
+
+mDeadDescriptor::~mDeadDescriptor()
+{
+    delete[] propertynames;
+}
+
+bool mDeadDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<mDead *>(obj)!=nullptr;
+}
+
+const char **mDeadDescriptor::getPropertyNames() const
+{
+    if (!propertynames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+        const char **basenames = basedesc ? basedesc->getPropertyNames() : nullptr;
+        propertynames = mergeLists(basenames, names);
+    }
+    return propertynames;
+}
+
+const char *mDeadDescriptor::getProperty(const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? basedesc->getProperty(propertyname) : nullptr;
+}
+
+int mDeadDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? 2+basedesc->getFieldCount() : 2;
+}
+
+unsigned int mDeadDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeFlags(field);
+        field -= basedesc->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,
+        FD_ISEDITABLE,
+    };
+    return (field>=0 && field<2) ? fieldTypeFlags[field] : 0;
+}
+
+const char *mDeadDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldName(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "id",
+        "round",
+    };
+    return (field>=0 && field<2) ? fieldNames[field] : nullptr;
+}
+
+int mDeadDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    int base = basedesc ? basedesc->getFieldCount() : 0;
+    if (fieldName[0]=='i' && strcmp(fieldName, "id")==0) return base+0;
+    if (fieldName[0]=='r' && strcmp(fieldName, "round")==0) return base+1;
+    return basedesc ? basedesc->findField(fieldName) : -1;
+}
+
+const char *mDeadDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeString(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "int",
+        "int",
+    };
+    return (field>=0 && field<2) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **mDeadDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldPropertyNames(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *mDeadDescriptor::getFieldProperty(int field, const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldProperty(field, propertyname);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int mDeadDescriptor::getFieldArraySize(void *object, int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldArraySize(object, field);
+        field -= basedesc->getFieldCount();
+    }
+    mDead *pp = (mDead *)object; (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+const char *mDeadDescriptor::getFieldDynamicTypeString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldDynamicTypeString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    mDead *pp = (mDead *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string mDeadDescriptor::getFieldValueAsString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldValueAsString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    mDead *pp = (mDead *)object; (void)pp;
+    switch (field) {
+        case 0: return long2string(pp->getId());
+        case 1: return long2string(pp->getRound());
+        default: return "";
+    }
+}
+
+bool mDeadDescriptor::setFieldValueAsString(void *object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->setFieldValueAsString(object,field,i,value);
+        field -= basedesc->getFieldCount();
+    }
+    mDead *pp = (mDead *)object; (void)pp;
+    switch (field) {
+        case 0: pp->setId(string2long(value)); return true;
+        case 1: pp->setRound(string2long(value)); return true;
+        default: return false;
+    }
+}
+
+const char *mDeadDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructName(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+void *mDeadDescriptor::getFieldStructValuePointer(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructValuePointer(object, field, i);
+        field -= basedesc->getFieldCount();
+    }
+    mDead *pp = (mDead *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
 
@@ -27,6 +27,8 @@
  * message mAdvertisement
  * {
  *     unsigned int id; // CH id
+ *     int x; // CH coordinates (used to simulate RSSI)
+ *     int y;
  * }
  * </pre>
  */
@@ -34,6 +36,8 @@ class mAdvertisement : public ::omnetpp::cMessage
 {
   protected:
     unsigned int id;
+    int x;
+    int y;
 
   private:
     void copy(const mAdvertisement& other);
@@ -54,13 +58,17 @@ class mAdvertisement : public ::omnetpp::cMessage
     // field getter/setter methods
     virtual unsigned int getId() const;
     virtual void setId(unsigned int id);
+    virtual int getX() const;
+    virtual void setX(int x);
+    virtual int getY() const;
+    virtual void setY(int y);
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const mAdvertisement& obj) {obj.parsimPack(b);}
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mAdvertisement& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>common.msg:23</tt> by nedtool.
+ * Class generated from <tt>common.msg:25</tt> by nedtool.
  * <pre>
  * // DATA message
  * message mData
@@ -103,12 +111,13 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const mData& obj) {obj.pars
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mData& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>common.msg:28</tt> by nedtool.
+ * Class generated from <tt>common.msg:30</tt> by nedtool.
  * <pre>
  * // JOIN message
  * message mJoin
  * {
  *     int id;
+ *     int round; // round number
  *     //string anotherField;
  *     //double arrayField1[];
  *     //double arrayField2[10];
@@ -119,6 +128,7 @@ class mJoin : public ::omnetpp::cMessage
 {
   protected:
     int id;
+    int round;
 
   private:
     void copy(const mJoin& other);
@@ -139,64 +149,69 @@ class mJoin : public ::omnetpp::cMessage
     // field getter/setter methods
     virtual int getId() const;
     virtual void setId(int id);
+    virtual int getRound() const;
+    virtual void setRound(int round);
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const mJoin& obj) {obj.parsimPack(b);}
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mJoin& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>common.msg:35</tt> by nedtool.
+ * Class generated from <tt>common.msg:38</tt> by nedtool.
  * <pre>
- * // SCHED message
- * message mSchedule
+ * // SCHED message (TDMA table of the whole cluster: member i transmits in turn i)
+ * message mScheduleTable
  * {
- *     int turn; // TDMA turn
  *     double duration; // TDMA slot duration
  *     int round; // round number
  *     int CHId; // CH id
+ *     int members[]; // member ids, in turn order
  * }
  * </pre>
  */
-class mSchedule : public ::omnetpp::cMessage
+class mScheduleTable : public ::omnetpp::cMessage
 {
   protected:
-    int turn;
     double duration;
     int round;
     int CHId;
+    int *members; // array ptr
+    unsigned int members_arraysize;
 
   private:
-    void copy(const mSchedule& other);
+    void copy(const mScheduleTable& other);
 
   protected:
     // protected and unimplemented operator==(), to prevent accidental usage
-    bool operator==(const mSchedule&);
+    bool operator==(const mScheduleTable&);
 
   public:
-    mSchedule(const char *name=nullptr, short kind=0);
-    mSchedule(const mSchedule& other);
-    virtual ~mSchedule();
-    mSchedule& operator=(const mSchedule& other);
-    virtual mSchedule *dup() const override {return new mSchedule(*this);}
+    mScheduleTable(const char *name=nullptr, short kind=0);
+    mScheduleTable(const mScheduleTable& other);
+    virtual ~mScheduleTable();
+    mScheduleTable& operator=(const mScheduleTable& other);
+    virtual mScheduleTable *dup() const override {return new mScheduleTable(*this);}
     virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
     virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
 
     // field getter/setter methods
-    virtual int getTurn() const;
-    virtual void setTurn(int turn);
     virtual double getDuration() const;
     virtual void setDuration(double duration);
     virtual int getRound() const;
     virtual void setRound(int round);
     virtual int getCHId() const;
     virtual void setCHId(int CHId);
+    virtual void setMembersArraySize(unsigned int size);
+    virtual unsigned int getMembersArraySize() const;
+    virtual int getMembers(unsigned int k) const;
+    virtual void setMembers(unsigned int k, int members);
 };
 
-inline void doParsimPacking(omnetpp::cCommBuffer *b, const mSchedule& obj) {obj.parsimPack(b);}
-inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mSchedule& obj) {obj.parsimUnpack(b);}
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const mScheduleTable& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mScheduleTable& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>common.msg:43</tt> by nedtool.
+ * Class generated from <tt>common.msg:46</tt> by nedtool.
  * <pre>
  * // ALTERNATIVE CH SELCTION
  * message mCenterCH
@@ -242,6 +257,151 @@ class mCenterCH : public ::omnetpp::cMessage
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const mCenterCH& obj) {obj.parsimPack(b);}
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mCenterCH& obj) {obj.parsimUnpack(b);}
 
+/**
+ * Class generated from <tt>common.msg:54</tt> by nedtool.
+ * <pre>
+ * // ASSIGN message (centralized clustering, LEACH-C)
+ * message mAssign
+ * {
+ *     int round; // round number
+ *     int CHId; // CH id (BS_ID if the node has to send directly to the BS)
+ *     int turn; // TDMA turn (if not CH)
+ *     double duration; // TDMA slot duration
+ *     int clusterN; // num. of sensors in cluster (if CH)
+ * }
+ * </pre>
+ */
+class mAssign : public ::omnetpp::cMessage
+{
+  protected:
+    int round;
+    int CHId;
+    int turn;
+    double duration;
+    int clusterN;
+
+  private:
+    void copy(const mAssign& other);
+
+  protected:
+    // protected and unimplemented operator==(), to prevent accidental usage
+    bool operator==(const mAssign&);
+
+  public:
+    mAssign(const char *name=nullptr, short kind=0);
+    mAssign(const mAssign& other);
+    virtual ~mAssign();
+    mAssign& operator=(const mAssign& other);
+    virtual mAssign *dup() const override {return new mAssign(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    // field getter/setter methods
+    virtual int getRound() const;
+    virtual void setRound(int round);
+    virtual int getCHId() const;
+    virtual void setCHId(int CHId);
+    virtual int getTurn() const;
+    virtual void setTurn(int turn);
+    virtual double getDuration() const;
+    virtual void setDuration(double duration);
+    virtual int getClusterN() const;
+    virtual void setClusterN(int clusterN);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const mAssign& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mAssign& obj) {obj.parsimUnpack(b);}
+
+/**
+ * Class generated from <tt>common.msg:63</tt> by nedtool.
+ * <pre>
+ * // RELAY message (multi-hop, aggregated data forwarded towards the BS)
+ * message mRelay
+ * {
+ *     int id; // CH that produced the aggregate
+ *     int round; // round number
+ *     int hops; // hops traveled so far
+ * }
+ * </pre>
+ */
+class mRelay : public ::omnetpp::cMessage
+{
+  protected:
+    int id;
+    int round;
+    int hops;
+
+  private:
+    void copy(const mRelay& other);
+
+  protected:
+    // protected and unimplemented operator==(), to prevent accidental usage
+    bool operator==(const mRelay&);
+
+  public:
+    mRelay(const char *name=nullptr, short kind=0);
+    mRelay(const mRelay& other);
+    virtual ~mRelay();
+    mRelay& operator=(const mRelay& other);
+    virtual mRelay *dup() const override {return new mRelay(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    // field getter/setter methods
+    virtual int getId() const;
+    virtual void setId(int id);
+    virtual int getRound() const;
+    virtual void setRound(int round);
+    virtual int getHops() const;
+    virtual void setHops(int hops);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const mRelay& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mRelay& obj) {obj.parsimUnpack(b);}
+
+/**
+ * Class generated from <tt>common.msg:70</tt> by nedtool.
+ * <pre>
+ * // DEAD message (partitioned network: tells the BS a node died)
+ * message mDead
+ * {
+ *     int id; // dead node
+ *     int round; // round number
+ * }
+ * </pre>
+ */
+class mDead : public ::omnetpp::cMessage
+{
+  protected:
+    int id;
+    int round;
+
+  private:
+    void copy(const mDead& other);
+
+  protected:
+    // protected and unimplemented operator==(), to prevent accidental usage
+    bool operator==(const mDead&);
+
+  public:
+    mDead(const char *name=nullptr, short kind=0);
+    mDead(const mDead& other);
+    virtual ~mDead();
+    mDead& operator=(const mDead& other);
+    virtual mDead *dup() const override {return new mDead(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    // field getter/setter methods
+    virtual int getId() const;
+    virtual void setId(int id);
+    virtual int getRound() const;
+    virtual void setRound(int round);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const mDead& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, mDead& obj) {obj.parsimUnpack(b);}
+
 
 #endif // ifndef __COMMON_M_H
 
@@ -0,0 +1,84 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+#include <cstring>
+#include <cinttypes>
+#include "digest.h"
+
+// FNV-1a, 64 bits
+static uint64_t fnv(uint64_t h, const void *data, size_t n)
+{
+    const unsigned char *p = (const unsigned char *) data;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static const uint64_t FNV_BASIS = 14695981039346656037ULL;
+
+bool StateDigest::open(const char *file, unsigned int N)
+{
+    close();
+    f = fopen(file, "w");
+    nodes.assign(N, FNV_BASIS);
+    return f != nullptr;
+}
+
+void StateDigest::close()
+{
+    if (f) fclose(f);
+    f = nullptr;
+}
+
+void StateDigest::setNode(int n, double energy, int role, int CH_id)
+{
+    uint64_t h = fnv(FNV_BASIS, &energy, sizeof(energy));
+    h = fnv(h, &role, sizeof(role));
+    nodes[n] = fnv(h, &CH_id, sizeof(CH_id));
+}
+
+void StateDigest::setDead(int n)
+{
+    int role = -1;  // whatever energy and CH the node was left with
+    nodes[n] = fnv(FNV_BASIS, &role, sizeof(role));
+}
+
+bool StateDigest::write(int round, unsigned int Ndead, unsigned int heads)
+{
+    uint64_t network = fnv(FNV_BASIS, &Ndead, sizeof(Ndead));
+    network = fnv(network, nodes.data(), nodes.size()*sizeof(uint64_t));
+    if (fprintf(f, "%d %u %u %016" PRIx64, round, Ndead, heads, network) < 0) return false;
+    for (unsigned int n = 0; n < nodes.size(); n++)
+        if (fprintf(f, " %016" PRIx64, nodes[n]) < 0) return false;
+    return fputc('\n', f) != EOF;
+}
+
+bool StateDigest::read(FILE *f, Round &r)
+{
+    if (fscanf(f, "%d %u %u %" SCNx64, &r.round, &r.Ndead, &r.heads, &r.network) != 4) return false;
+    r.nodes.clear();
+    for (int c = fgetc(f); c != '\n' && c != EOF; c = fgetc(f)) {
+        if (c == ' ') continue;
+        ungetc(c, f);
+        uint64_t h;
+        if (fscanf(f, "%" SCNx64, &h) != 1) return false;
+        r.nodes.push_back(h);
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+#ifndef __IMPRO_LEACH_DIGEST_H_
+#define __IMPRO_LEACH_DIGEST_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Per-round hashes of the state of a network, to check that two execution
+ * modes (e.g. Base_net and Field_net, or an optimization on and off) run the
+ * same simulation. A node hashes its energy (bit exact), role and CH; a dead
+ * node only its role. Text file, one line per round boundary:
+ *   round Ndead CHs network-hash node-hash[0] ... node-hash[N-1]   (hashes in hex)
+ * where CHs are the alive CHs of the round just over. Compare two files with
+ * tools/digestdiff: hashes for the same simulation, CHs for the same statistics.
+ */
+class StateDigest
+{
+  private:
+    FILE *f;
+    std::vector<uint64_t> nodes;
+
+  public:
+    struct Round {
+        int round;
+        unsigned int Ndead;
+        unsigned int heads;
+        uint64_t network;
+        std::vector<uint64_t> nodes;
+    };
+
+    StateDigest() : f(nullptr) {}
+    ~StateDigest() { close(); }
+    bool open(const char *file, unsigned int N);
+    void close();
+    bool isOpen() const { return f != nullptr; }
+
+    void setNode(int n, double energy, int role, int CH_id);
+    void setDead(int n);
+    /** Write the line of a round with the nodes set so far; returns false on I/O errors. */
+    bool write(int round, unsigned int Ndead, unsigned int heads);
+    /** Next line of a digest file; false at the end or on a malformed line. */
+    static bool read(FILE *f, Round &r);
+};
+
+#endif
@@ -0,0 +1,155 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <cmath>
+#include <climits>
+#include "election.h"
+
+unsigned int leachEpoch(double P)
+{
+    if (P <= 0) return UINT_MAX;  // nobody will ever be CH
+    unsigned int epoch = (unsigned int) round(1/P);
+    return (epoch > 0) ? epoch : 1;
+}
+
+double leachThreshold(double P, unsigned int r)
+{
+    if (P <= 0) return 0;
+    double den = 1 - P * (r % leachEpoch(P));
+    if (den <= 0) return 1;
+    double th = P / den;
+    return (th < 1) ? th : 1;
+}
+
+ElectionEngine::ElectionEngine()
+{
+    setup(0, 0);
+}
+
+void ElectionEngine::setup(unsigned int capacity, double P)
+{
+    this->P = P;
+    epoch = leachEpoch(P);
+    eligible.clear();
+    eligible.reserve(capacity);
+    pos.assign(capacity, -1);
+    alive.assign(capacity, 0);
+    elected.assign(capacity, 0);
+    heads.clear();
+    round = -1;
+    draws = 0;
+}
+
+void ElectionEngine::makeEligible(int id)
+{
+    if (pos[id] >= 0) return;
+    pos[id] = eligible.size();
+    eligible.push_back(id);
+}
+
+void ElectionEngine::makeIneligible(int id)
+{
+    if (pos[id] < 0) return;
+    int last = eligible.back();
+    eligible[pos[id]] = last;
+    pos[last] = pos[id];
+    eligible.pop_back();
+    pos[id] = -1;
+}
+
+void ElectionEngine::addNode(int id, bool eligible)
+{
+    if (id >= (int) pos.size()) {
+        pos.resize(id + 1, -1);
+        alive.resize(id + 1, 0);
+        elected.resize(id + 1, 0);
+    }
+    alive[id] = 1;
+    if (eligible) makeEligible(id);
+}
+
+void ElectionEngine::removeNode(int id)
+{
+    alive[id] = 0;
+    makeIneligible(id);
+}
+
+void ElectionEngine::markCH(int id)
+{
+    makeIneligible(id);
+}
+
+void ElectionEngine::unmarkCH(int id)
+{
+    if (alive[id]) makeEligible(id);
+}
+
+void ElectionEngine::setEligible(const std::vector<int> &ids)
+{
+    for (unsigned int i = 0; i < eligible.size(); i++)
+        pos[eligible[i]] = -1;
+    eligible.clear();
+    for (unsigned int i = 0; i < ids.size(); i++)
+        if (alive[ids[i]]) makeEligible(ids[i]);
+}
+
+const std::vector<int> &ElectionEngine::elect(unsigned int r, const std::function<double()> &uniform01, const std::vector<int> &aliveIds)
+{
+    if ((long) r == round)
+        return heads;
+    round = r;
+
+    for (unsigned int i = 0; i < heads.size(); i++)
+        elected[heads[i]] = 0;
+    heads.clear();
+
+    if (r % epoch == 0) {
+        // new epoch: every alive node can be CH again
+        for (unsigned int i = 0; i < eligible.size(); i++)
+            pos[eligible[i]] = -1;
+        eligible.clear();
+        for (unsigned int i = 0; i < aliveIds.size(); i++)
+            if (alive[aliveIds[i]]) makeEligible(aliveIds[i]);
+    }
+
+    double th = leachThreshold(P, r);
+    const unsigned long n = eligible.size();
+    if (th <= 0 || n == 0)
+        return heads;
+
+    if (th >= 1) {
+        heads = eligible;
+    } else {
+        // skip over the non elected nodes: gap ~ Geometric(th)
+        const double logq = log(1 - th);
+        unsigned long i = 0;
+        while (true) {
+            double u = 1 - uniform01();     // (0,1]
+            draws++;
+            double gap = floor(log(u) / logq);
+            if (gap >= (double) (n - i)) break;
+            i += (unsigned long) gap;
+            heads.push_back(eligible[i]);
+            i++;
+            if (i >= n) break;
+        }
+    }
+
+    for (unsigned int j = 0; j < heads.size(); j++) {
+        elected[heads[j]] = 1;
+        makeIneligible(heads[j]);
+    }
+    return heads;
+}
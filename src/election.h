@@ -0,0 +1,75 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_ELECTION_H_
+#define __IMPRO_LEACH_ELECTION_H_
+
+#include <vector>
+#include <functional>
+
+// rounds in a LEACH epoch (1/P): every node is CH once per epoch
+unsigned int leachEpoch(double P);
+// T(n) threshold for a node that has not been CH yet in the current epoch
+double leachThreshold(double P, unsigned int r);
+
+/**
+ * Stochastic CH election for the whole network.
+ * Keeps the set of alive nodes that have not been CH in the current epoch, all of them
+ * having the same threshold T(r). Instead of one Bernoulli draw per node, the gaps between
+ * elected nodes are drawn from the geometric distribution: the elected set has exactly the
+ * distribution of independent per-node draws (the number of heads is Binomial(n, T)),
+ * but only k+1 random numbers are needed.
+ */
+class ElectionEngine
+{
+  private:
+    double P;
+    unsigned int epoch;
+
+    std::vector<int> eligible;  // not yet CH in the current epoch (compact)
+    std::vector<int> pos;       // position in eligible (-1 if not eligible)
+    std::vector<char> alive;
+    std::vector<char> elected;  // elected in the current round
+    std::vector<int> heads;     // elected in the current round
+    long round;                 // last round drawn (-1: none)
+    unsigned long draws;        // random numbers used so far
+
+    void makeEligible(int id);
+    void makeIneligible(int id);
+
+  public:
+    ElectionEngine();
+    void setup(unsigned int capacity, double P);
+
+    void addNode(int id, bool eligible = true);    // alive (and eligible, unless it waits for the next epoch)
+    void removeNode(int id);    // dead
+    void markCH(int id);        // has been CH in this epoch
+    void unmarkCH(int id);      // gave the CH role away, can be elected again
+
+    /**
+     * Run the election for round r (only the first call of a round draws).
+     * uniform01() must return numbers in [0,1); aliveIds refills the eligible set
+     * when a new epoch starts.
+     */
+    const std::vector<int> &elect(unsigned int r, const std::function<double()> &uniform01, const std::vector<int> &aliveIds);
+    bool isElected(int id) const { return elected[id] != 0; }
+
+    unsigned int getEligible() const { return eligible.size(); }
+    const std::vector<int> &getEligibleList() const { return eligible; }
+    void setEligible(const std::vector<int> &ids);  // replaces the eligible set, keeping the order (restore)
+    unsigned long getDraws() const { return draws; }
+};
+
+#endif
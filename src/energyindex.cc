@@ -0,0 +1,123 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <queue>
+#include "energyindex.h"
+
+void EnergyIndex::setup(unsigned int capacity)
+{
+    heap.clear();
+    heap.reserve(capacity);
+    pos.assign(capacity, -1);
+    energy.assign(capacity, 0);
+}
+
+void EnergyIndex::siftUp(unsigned int i)
+{
+    int id = heap[i];
+    while (i > 0) {
+        unsigned int parent = (i-1) / 2;
+        if (!above(id, heap[parent])) break;
+        place(i, heap[parent]);
+        i = parent;
+    }
+    place(i, id);
+}
+
+void EnergyIndex::siftDown(unsigned int i)
+{
+    int id = heap[i];
+    const unsigned int n = heap.size();
+    while (true) {
+        unsigned int child = 2*i + 1;
+        if (child >= n) break;
+        if (child+1 < n && above(heap[child+1], heap[child])) child++;
+        if (!above(heap[child], id)) break;
+        place(i, heap[child]);
+        i = child;
+    }
+    place(i, id);
+}
+
+void EnergyIndex::insert(int id, double e)
+{
+    if ((unsigned int) id >= pos.size()) {
+        pos.resize(id+1, -1);
+        energy.resize(id+1, 0);
+    }
+    if (pos[id] >= 0) {
+        update(id, e);
+        return;
+    }
+    energy[id] = e;
+    heap.push_back(id);
+    pos[id] = heap.size()-1;
+    siftUp(heap.size()-1);
+}
+
+void EnergyIndex::update(int id, double e)
+{
+    if (!contains(id)) {
+        insert(id, e);
+        return;
+    }
+    double old = energy[id];
+    energy[id] = e;
+    if (e > old) siftUp(pos[id]);
+    else siftDown(pos[id]);
+}
+
+void EnergyIndex::remove(int id)
+{
+    if (!contains(id)) return;
+    unsigned int i = pos[id];
+    int last = heap.back();
+    heap.pop_back();
+    pos[id] = -1;
+    if (i < heap.size()) {
+        place(i, last);
+        siftUp(i);
+        siftDown(pos[last]);
+    }
+}
+
+void EnergyIndex::top(unsigned int k, std::vector<int> &ids) const
+{
+    // best-first visit of the heap: the frontier holds the children of the nodes taken so far
+    struct Below {
+        const EnergyIndex *index;
+        bool operator()(unsigned int a, unsigned int b) const { return index->above(index->heap[b], index->heap[a]); }
+    };
+    Below below = { this };
+    std::priority_queue<unsigned int, std::vector<unsigned int>, Below> frontier(below);
+    if (!heap.empty()) frontier.push(0);
+    while (ids.size() < k && !frontier.empty()) {
+        unsigned int i = frontier.top();
+        frontier.pop();
+        ids.push_back(heap[i]);
+        if (2*i+1 < heap.size()) frontier.push(2*i+1);
+        if (2*i+2 < heap.size()) frontier.push(2*i+2);
+    }
+}
+
+int EnergyIndex::best(const std::vector<int> &ids) const
+{
+    int b = -1;
+    for (unsigned int i = 0; i < ids.size(); i++)
+        if (contains(ids[i]) && (b < 0 || energy[ids[i]] > energy[b]))
+            b = ids[i];
+    return b;
+}
@@ -0,0 +1,59 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_ENERGYINDEX_H_
+#define __IMPRO_LEACH_ENERGYINDEX_H_
+
+#include <vector>
+
+/**
+ * Residual energy of the alive nodes, ranked: an indexed binary max-heap
+ * (ties go to the lower id), updated in O(log N) when a node spends energy.
+ * Energies are also kept by id, so the best node of any set is found
+ * without asking the node modules.
+ */
+class EnergyIndex
+{
+  private:
+    std::vector<int> heap;      // ids, the highest energy first
+    std::vector<int> pos;       // position of each id in heap (-1: not in the index)
+    std::vector<double> energy; // by id
+
+    bool above(int a, int b) const { return energy[a] > energy[b] || (energy[a] == energy[b] && a < b); }
+    void place(unsigned int i, int id) { heap[i] = id; pos[id] = i; }
+    void siftUp(unsigned int i);
+    void siftDown(unsigned int i);
+
+  public:
+    void setup(unsigned int capacity);
+
+    void insert(int id, double e);
+    void update(int id, double e);  // also inserts
+    void remove(int id);
+
+    bool contains(int id) const { return id >= 0 && (unsigned int) id < pos.size() && pos[id] >= 0; }
+    double get(int id) const { return energy[id]; }
+    unsigned int size() const { return heap.size(); }
+
+    /** Node with the highest energy (-1 if empty). */
+    int top() const { return heap.empty() ? -1 : heap[0]; }
+    /** The k nodes with the highest energy, best first, in O(k log k). */
+    void top(unsigned int k, std::vector<int> &ids) const;
+    /** Node of ids in the index with the highest energy, the first one of ids if tied (-1 if none). */
+    int best(const std::vector<int> &ids) const;
+};
+
+#endif
@@ -0,0 +1,122 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <cmath>
+#include <algorithm>
+#include "grid.h"
+
+SpatialGrid::SpatialGrid()
+{
+    setup(0, 0, 0, 1, 1, 1);
+}
+
+void SpatialGrid::setup(unsigned int capacity, double minX, double minY, double maxX, double maxY, double cell)
+{
+    this->minX = minX;
+    this->minY = minY;
+    this->cell = (cell > 0) ? cell : 1;
+    nx = std::max(1, (int) ceil((maxX - minX) / this->cell));
+    ny = std::max(1, (int) ceil((maxY - minY) / this->cell));
+
+    cells.assign(nx*ny, std::vector<int>());
+    cellOf.assign(capacity, -1);
+    slotOf.assign(capacity, -1);
+    px.assign(capacity, 0);
+    py.assign(capacity, 0);
+    count = 0;
+}
+
+void SpatialGrid::resize(unsigned int capacity)
+{
+    if (capacity <= cellOf.size()) return;
+    cellOf.resize(capacity, -1);
+    slotOf.resize(capacity, -1);
+    px.resize(capacity, 0);
+    py.resize(capacity, 0);
+}
+
+int SpatialGrid::cellX(double x) const
+{
+    int i = (int) floor((x - minX) / cell);
+    return std::min(std::max(i, 0), nx - 1);
+}
+
+int SpatialGrid::cellY(double y) const
+{
+    int j = (int) floor((y - minY) / cell);
+    return std::min(std::max(j, 0), ny - 1);
+}
+
+void SpatialGrid::link(int id, int c)
+{
+    cellOf[id] = c;
+    slotOf[id] = cells[c].size();
+    cells[c].push_back(id);
+}
+
+void SpatialGrid::unlink(int id)
+{
+    std::vector<int> &c = cells[cellOf[id]];
+    int last = c.back();
+    c[slotOf[id]] = last;   // swap with the last node of the cell
+    slotOf[last] = slotOf[id];
+    c.pop_back();
+    cellOf[id] = -1;
+    slotOf[id] = -1;
+}
+
+void SpatialGrid::insert(int id, double x, double y)
+{
+    if (contains(id)) {
+        move(id, x, y);
+        return;
+    }
+    px[id] = x;
+    py[id] = y;
+    link(id, cellY(y)*nx + cellX(x));
+    count++;
+}
+
+void SpatialGrid::remove(int id)
+{
+    if (!contains(id)) return;
+    unlink(id);
+    count--;
+}
+
+void SpatialGrid::move(int id, double x, double y)
+{
+    if (!contains(id)) {
+        insert(id, x, y);
+        return;
+    }
+    px[id] = x;
+    py[id] = y;
+    int c = cellY(y)*nx + cellX(x);
+    if (c != cellOf[id]) {
+        // only nodes crossing a cell border are touched
+        unlink(id);
+        link(id, c);
+    }
+}
+
+void SpatialGrid::clear()
+{
+    for (unsigned int c = 0; c < cells.size(); c++)
+        cells[c].clear();
+    std::fill(cellOf.begin(), cellOf.end(), -1);
+    std::fill(slotOf.begin(), slotOf.end(), -1);
+    count = 0;
+}
@@ -0,0 +1,84 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_GRID_H_
+#define __IMPRO_LEACH_GRID_H_
+
+#include <vector>
+
+/**
+ * Uniform grid over the deployment area. Insert, remove and move are O(1)
+ * (each node remembers its cell and its slot inside the cell).
+ * Points outside the area are clamped to the border cells.
+ */
+class SpatialGrid
+{
+  private:
+    double minX, minY;
+    double cell;            // cell edge (m)
+    int nx, ny;             // number of cells per axis
+
+    std::vector<std::vector<int> > cells;
+    std::vector<int> cellOf;    // cell of each node (-1 if not in the grid)
+    std::vector<int> slotOf;    // position of each node inside its cell
+    std::vector<double> px, py; // node positions
+    unsigned int count;
+
+    void link(int id, int c);
+    void unlink(int id);
+
+  public:
+    SpatialGrid();
+    void setup(unsigned int capacity, double minX, double minY, double maxX, double maxY, double cell);
+    void resize(unsigned int capacity);
+
+    void insert(int id, double x, double y);
+    void remove(int id);
+    void move(int id, double x, double y);
+    void clear();
+
+    bool contains(int id) const { return id >= 0 && id < (int) cellOf.size() && cellOf[id] >= 0; }
+    unsigned int size() const { return count; }
+    double getX(int id) const { return px[id]; }
+    double getY(int id) const { return py[id]; }
+    double getCell() const { return cell; }
+
+    int cellX(double x) const;
+    int cellY(double y) const;
+
+    /**
+     * Call f(id) for every node in the cells at Chebyshev distance k from cell (cx,cy).
+     * Returns false when the ring lies completely outside the grid.
+     */
+    template<typename F>
+    bool forRing(int cx, int cy, int k, F f) const
+    {
+        bool inside = false;
+        for (int j = cy - k; j <= cy + k; j++) {
+            if (j < 0 || j >= ny) continue;
+            int step = (j == cy - k || j == cy + k) ? 1 : 2*k;
+            for (int i = cx - k; i <= cx + k; i += (step > 0 ? step : 1)) {
+                if (i < 0 || i >= nx) continue;
+                inside = true;
+                const std::vector<int> &c = cells[j*nx + i];
+                for (unsigned int n = 0; n < c.size(); n++)
+                    f(c[n]);
+            }
+        }
+        return inside;
+    }
+};
+
+#endif
@@ -0,0 +1,60 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "inbox.h"
+
+MemberInbox::MemberInbox()
+{
+    round = 0;
+    peak = 0;
+    expected = 0;
+}
+
+void MemberInbox::open(int r)
+{
+    if (r != round) {
+        expected = peak;
+        peak = 0;
+    }
+    round = r;
+    forget();
+    // reserve as much as the previous round needed
+    ids.reserve(expected);
+}
+
+bool MemberInbox::add(int id, int r)
+{
+    if (r != round) return false;
+    if (id < 0) return false;
+    if ((unsigned int) id >= present.size()) present.resize(id + 1, false);
+    if (present[id]) return false;
+    present[id] = true;
+    ids.push_back(id);
+    if (ids.size() > peak) peak = ids.size();
+    return true;
+}
+
+void MemberInbox::clear()
+{
+    forget();
+}
+
+void MemberInbox::forget()
+{
+    // only the bits of the current members are set: O(members), not O(N)
+    for (unsigned int i = 0; i < ids.size(); i++)
+        present[ids[i]] = false;
+    ids.clear();
+}
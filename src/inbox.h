@@ -0,0 +1,53 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_INBOX_H_
+#define __IMPRO_LEACH_INBOX_H_
+
+#include <vector>
+
+/**
+ * Per-round membership inbox of a CH (or of the BS): the ids of the nodes that
+ * sent a JOIN (or a DATA) in the current round, in order of arrival.
+ * Messages of other rounds and duplicated senders are discarded, so the
+ * messages themselves can be deleted as soon as they arrive.
+ */
+class MemberInbox
+{
+  private:
+    std::vector<int> ids;       // members, in order of arrival (TDMA turn order)
+    std::vector<bool> present;  // present[id]: id is in ids (grown on demand, cleared through ids)
+    int round;
+    unsigned int peak;          // largest size reached in the current round
+    unsigned int expected;      // largest size reached in the previous round
+
+    void forget();
+
+  public:
+    MemberInbox();
+
+    /** Start collecting the members of round r (the inbox is emptied). */
+    void open(int r);
+    /** Add a member; returns false if the message is of another round or a duplicate. */
+    bool add(int id, int r);
+    /** Empty the inbox, staying in the same round. */
+    void clear();
+
+    unsigned int size() const { return ids.size(); }
+    int at(unsigned int i) const { return ids[i]; }
+    const std::vector<int> &list() const { return ids; }
+};
+
+#endif
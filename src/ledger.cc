@@ -0,0 +1,59 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include "ledger.h"
+
+// relative margin kept between the debts and the battery (rounding of the sums is ~1e-16 per cost)
+static const double SAFETY = 1e-9;
+
+EnergyLedger::EnergyLedger() : deferred(0)
+{
+}
+
+void EnergyLedger::setup(unsigned int N)
+{
+    costs.assign(N, std::vector<double>());
+    pending.assign(N, 0);
+    debtors.clear();
+    deferred = 0;
+}
+
+bool EnergyLedger::defer(int id, double cost, double energy)
+{
+    if ((unsigned int) id >= costs.size() || !(pending[id] + cost < energy * (1 - SAFETY)))
+        return false;
+    if (costs[id].empty()) debtors.push_back(id);
+    costs[id].push_back(cost);
+    pending[id] += cost;
+    deferred++;
+    return true;
+}
+
+void EnergyLedger::take(int id, std::vector<double> &out)
+{
+    out.clear();
+    if ((unsigned int) id >= costs.size()) return;
+    out.swap(costs[id]);
+    pending[id] = 0;
+}
+
+void EnergyLedger::takeDebtors(std::vector<int> &out)
+{
+    out.clear();
+    for (unsigned int i = 0; i < debtors.size(); i++)
+        if (owes(debtors[i])) out.push_back(debtors[i]);
+    debtors.clear();
+}
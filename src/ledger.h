@@ -0,0 +1,53 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_LEDGER_H_
+#define __IMPRO_LEACH_LEDGER_H_
+
+#include <vector>
+
+/**
+ * Energy spent by the nodes and not yet subtracted from their battery.
+ * A cost is only deferred if it can't kill the node, even added to what the
+ * node already owes (with a relative margin well above the rounding of the
+ * sums); otherwise the node settles and pays it at once. Costs are kept in
+ * order, so settling subtracts them one by one and gives the same energy,
+ * bit for bit, as paying them when they happen.
+ */
+class EnergyLedger
+{
+  private:
+    std::vector<std::vector<double> > costs;    // per node, in order
+    std::vector<double> pending;                // per node, sum of costs
+    std::vector<int> debtors;                   // nodes with costs (maybe settled since)
+    unsigned long deferred;
+
+  public:
+    EnergyLedger();
+    void setup(unsigned int N);
+
+    /** Record cost for node id if it leaves energy (its battery, before paying the debts) safe; returns false otherwise. */
+    bool defer(int id, double cost, double energy);
+    bool owes(int id) const { return (unsigned int) id < costs.size() && !costs[id].empty(); }
+    /** Move the costs of node id, in order, to out (which is emptied first). */
+    void take(int id, std::vector<double> &out);
+    /** Move the nodes that owe something to out, and forget them. */
+    void takeDebtors(std::vector<int> &out);
+
+    unsigned long getDeferred() const { return deferred; }
+};
+
+#endif
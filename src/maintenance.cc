@@ -0,0 +1,54 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <cstdio>
+#include "maintenance.h"
+
+MaintenancePlan::MaintenancePlan() : nextSeq(0), done(0)
+{
+}
+
+bool MaintenancePlan::load(const char *file, unsigned int N)
+{
+    FILE *f = fopen(file, "r");
+    if (!f) return false;
+    double t, energy;
+    int node;
+    while (fscanf(f, "%lf %d %lf", &t, &node, &energy) == 3)
+        if (node >= 0 && node < (int) N)
+            add(t, node, energy);
+    bool ok = feof(f);
+    fclose(f);
+    return ok;
+}
+
+void MaintenancePlan::add(double t, int node, double energy)
+{
+    Action action;
+    action.t = t;
+    action.node = node;
+    action.energy = energy;
+    action.seq = nextSeq++;
+    actions.push(action);
+}
+
+MaintenancePlan::Action MaintenancePlan::pop()
+{
+    Action action = actions.top();
+    actions.pop();
+    done++;
+    return action;
+}
@@ -0,0 +1,64 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_MAINTENANCE_H_
+#define __IMPRO_LEACH_MAINTENANCE_H_
+
+#include <cstdint>
+#include <vector>
+#include <queue>
+
+/**
+ * Field maintenance of the network, carried out by the BS (see the maintenanceFile
+ * and reviveAfter parameters of Base_net): at a given time a node gets a new battery.
+ * An alive node just goes on with it, a dead one comes back, and a spare (a node not
+ * deployed yet) is deployed. Actions are kept by time, then in the order they were
+ * added (file order first).
+ */
+class MaintenancePlan
+{
+  public:
+    struct Action {
+        double t;
+        int node;
+        double energy;      // new battery (J); < 0: like the initial one
+        uint64_t seq;
+    };
+
+  private:
+    struct Later {
+        bool operator()(const Action &a, const Action &b) const { return (a.t > b.t) || (a.t == b.t && a.seq > b.seq); }
+    };
+
+    std::priority_queue<Action, std::vector<Action>, Later> actions;
+    uint64_t nextSeq;
+    unsigned long done;
+
+  public:
+    MaintenancePlan();
+
+    /** One "time node energy" line per action (nodes out of 0..N-1 are skipped); returns false if it can't be read. */
+    bool load(const char *file, unsigned int N);
+    void add(double t, int node, double energy);
+
+    bool pending() const { return !actions.empty(); }
+    double next() const { return actions.top().t; }
+    Action pop();
+
+    unsigned long getDone() const { return done; }
+};
+
+#endif
@@ -0,0 +1,138 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include "mobility.h"
+
+Mobility::Mobility() : type(NONE), minX(0), minY(0), maxX(0), maxY(0), minSpeed(0), maxSpeed(0), pause(0), nextFix(0)
+{
+}
+
+void Mobility::setup(unsigned int capacity, double minX, double minY, double maxX, double maxY)
+{
+    this->minX = minX;
+    this->minY = minY;
+    this->maxX = maxX;
+    this->maxY = maxY;
+    moving.clear();
+    pos.assign(capacity, -1);
+    sx.assign(capacity, 0);
+    sy.assign(capacity, 0);
+    tx.assign(capacity, 0);
+    ty.assign(capacity, 0);
+    t0.assign(capacity, 0);
+    t1.assign(capacity, 0);
+    draws.assign(capacity, 0);
+    x.assign(capacity, 0);
+    y.assign(capacity, 0);
+    stamps.assign(capacity, 0);
+    fixes.clear();
+    nextFix = 0;
+}
+
+void Mobility::setWaypoint(double minSpeed, double maxSpeed, double pause)
+{
+    type = WAYPOINT;
+    this->minSpeed = minSpeed;
+    this->maxSpeed = maxSpeed;
+    this->pause = pause;
+}
+
+bool Mobility::loadTrace(const char *file)
+{
+    type = TRACE;
+    FILE *f = fopen(file, "r");
+    if (!f) return false;
+    Fix fix;
+    while (fscanf(f, "%lf %d %d %d", &fix.t, &fix.node, &fix.x, &fix.y) == 4)
+        if (fix.node >= 0 && fix.node < (int) x.size())
+            fixes.push_back(fix);
+    bool ok = feof(f);
+    fclose(f);
+    // same time: in file order
+    std::stable_sort(fixes.begin(), fixes.end(), [](const Fix &a, const Fix &b) { return a.t < b.t; });
+    return ok;
+}
+
+void Mobility::place(int n, int px, int py, double t)
+{
+    x[n] = px;
+    y[n] = py;
+    sx[n] = tx[n] = px;
+    sy[n] = ty[n] = py;
+    t0[n] = t1[n] = t - pause;  // the first leg starts at time t
+    if (pos[n] < 0) {
+        pos[n] = moving.size();
+        moving.push_back(n);
+    }
+}
+
+void Mobility::stop(int n)
+{
+    if (pos[n] < 0) return;
+    int last = moving.back();
+    moving[pos[n]] = last;
+    pos[last] = pos[n];
+    moving.pop_back();
+    pos[n] = -1;
+}
+
+void Mobility::setPosition(int n, int px, int py, std::vector<int> &moved)
+{
+    if (px == x[n] && py == y[n]) return;
+    x[n] = px;
+    y[n] = py;
+    stamps[n]++;
+    moved.push_back(n);
+}
+
+void Mobility::advance(double t, const Draw &draw, std::vector<int> &moved)
+{
+    moved.clear();
+    if (type == TRACE) {
+        for (; nextFix < fixes.size() && fixes[nextFix].t <= t; nextFix++) {
+            const Fix &fix = fixes[nextFix];
+            if (pos[fix.node] >= 0)
+                setPosition(fix.node, fix.x, fix.y, moved);
+        }
+        return;
+    }
+    if (type != WAYPOINT) return;
+
+    for (unsigned int i = 0; i < moving.size(); i++) {
+        int n = moving[i];
+        // legs (and pauses) over by t: the next one leaves from the waypoint
+        while (t >= t1[n] + pause) {
+            sx[n] = tx[n];
+            sy[n] = ty[n];
+            t0[n] = t1[n] + pause;
+            tx[n] = minX + draw(n, draws[n]++) * (maxX - minX);
+            ty[n] = minY + draw(n, draws[n]++) * (maxY - minY);
+            double speed = minSpeed + draw(n, draws[n]++) * (maxSpeed - minSpeed);
+            t1[n] = t0[n] + sqrt(pow(tx[n] - sx[n], 2) + pow(ty[n] - sy[n], 2)) / speed;
+        }
+        double px = tx[n], py = ty[n];
+        if (t < t1[n]) {
+            double f = (t - t0[n]) / (t1[n] - t0[n]);
+            px = sx[n] + f * (tx[n] - sx[n]);
+            py = sy[n] + f * (ty[n] - sy[n]);
+        }
+        setPosition(n, (int) round(px), (int) round(py), moved);
+    }
+}
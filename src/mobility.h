@@ -0,0 +1,85 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+#ifndef __IMPRO_LEACH_MOBILITY_H_
+#define __IMPRO_LEACH_MOBILITY_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+/**
+ * Movement of the nodes, advanced in steps by the BS (see the mobility parameter
+ * of Base_net). Random waypoint: each node goes at a uniform speed to a uniform
+ * point of the area, pauses, and leaves again. Trace: positions of nodes at given
+ * times, taken at the first step at or after that time.
+ * Positions are integer meters, like those of the sensors: a step only reports the
+ * nodes whose position changed, and counts the moves of each node, so that cached
+ * distances can tell whether they are still valid (see getStamp()).
+ */
+class Mobility
+{
+  public:
+    enum model { NONE, WAYPOINT, TRACE };
+    // draw k of node n, uniform in [0,1)
+    typedef std::function<double(int n, unsigned int k)> Draw;
+
+  private:
+    model type;
+    double minX, minY, maxX, maxY;
+    double minSpeed, maxSpeed, pause;
+
+    std::vector<int> moving;        // nodes still moving (compact)
+    std::vector<int> pos;           // position in moving (-1 if stopped)
+    std::vector<double> sx, sy;     // start of the current leg
+    std::vector<double> tx, ty;     // waypoint
+    std::vector<double> t0, t1;     // departure from the start, arrival at the waypoint
+    std::vector<unsigned int> draws;
+    std::vector<int> x, y;          // current (integer) position
+    std::vector<uint32_t> stamps;   // moves of each node so far
+
+    struct Fix {
+        double t;
+        int node;
+        int x, y;
+    };
+    std::vector<Fix> fixes;         // trace, by time
+    size_t nextFix;
+
+    void setPosition(int n, int px, int py, std::vector<int> &moved);
+
+  public:
+    Mobility();
+    void setup(unsigned int capacity, double minX, double minY, double maxX, double maxY);
+    void setWaypoint(double minSpeed, double maxSpeed, double pause);
+    /** Trace file: one "time node x y" line per fix; returns false if it can't be read. */
+    bool loadTrace(const char *file);
+
+    void place(int n, int x, int y, double t = 0);  // position at time t (deployment), the node moves from there
+    void stop(int n);                   // dead: doesn't move any more
+
+    /** Move the nodes up to time t; moved gets the nodes whose position changed. */
+    void advance(double t, const Draw &draw, std::vector<int> &moved);
+
+    model getType() const { return type; }
+    int getX(int n) const { return x[n]; }
+    int getY(int n) const { return y[n]; }
+    uint32_t getStamp(int n) const { return stamps[n]; }
+};
+
+#endif
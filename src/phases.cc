@@ -0,0 +1,75 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include "phases.h"
+
+PhaseScheduler::PhaseScheduler() : fired(0), wakes(0)
+{
+}
+
+void PhaseScheduler::grow(int kind, int id)
+{
+    if ((unsigned int) kind >= gen.size()) {
+        gen.resize(kind+1);
+        armed.resize(kind+1);
+    }
+    if ((unsigned int) id >= gen[kind].size()) {
+        gen[kind].resize(id+1, 0);
+        armed[kind].resize(id+1, false);
+    }
+}
+
+bool PhaseScheduler::schedule(int64_t t, int kind, int id)
+{
+    grow(kind, id);
+    Entry e;
+    e.id = id;
+    e.gen = ++gen[kind][id];   // an older entry of the same timer becomes stale
+    armed[kind][id] = true;
+
+    std::vector<Entry> &bucket = buckets[Key(t, kind)];
+    bucket.push_back(e);
+    return bucket.size() == 1;
+}
+
+void PhaseScheduler::cancel(int kind, int id)
+{
+    if (!isScheduled(kind, id)) return;
+    ++gen[kind][id];
+    armed[kind][id] = false;
+}
+
+bool PhaseScheduler::isScheduled(int kind, int id) const
+{
+    return (unsigned int) kind < armed.size() && (unsigned int) id < armed[kind].size() && armed[kind][id];
+}
+
+void PhaseScheduler::take(int64_t t, int kind, std::vector<int> &ids)
+{
+    std::map<Key, std::vector<Entry> >::iterator it = buckets.find(Key(t, kind));
+    if (it == buckets.end()) return;
+    unsigned long before = fired;
+    for (unsigned int i = 0; i < it->second.size(); i++) {
+        const Entry &e = it->second[i];
+        if (armed[kind][e.id] && gen[kind][e.id] == e.gen) {
+            armed[kind][e.id] = false;
+            ids.push_back(e.id);
+            fired++;
+        }
+    }
+    if (fired > before) wakes++;
+    buckets.erase(it);
+}
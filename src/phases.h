@@ -0,0 +1,65 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_PHASES_H_
+#define __IMPRO_LEACH_PHASES_H_
+
+#include <vector>
+#include <map>
+#include <cstdint>
+
+/**
+ * Timers of the sensors grouped by LEACH phase: all the timers of the same
+ * kind that expire at the same time (e.g. the RCVD_ADV of every non-CH node)
+ * share one bucket, and the owner puts a single event in the FES per bucket.
+ * A node has at most one pending timer per kind; cancelling it is O(1), the
+ * stale entry is skipped when its bucket fires.
+ * Times are raw simulation times (SimTime::raw()).
+ */
+class PhaseScheduler
+{
+  private:
+    struct Entry {
+        int id;
+        uint32_t gen;
+    };
+    typedef std::pair<int64_t, int> Key;    // (time, kind)
+
+    std::map<Key, std::vector<Entry> > buckets;
+    std::vector<std::vector<uint32_t> > gen;    // per kind and node: generation of the pending timer
+    std::vector<std::vector<bool> > armed;      // per kind and node: a timer is pending
+    unsigned long fired;        // timers dispatched
+    unsigned long wakes;        // buckets dispatched
+
+    void grow(int kind, int id);
+
+  public:
+    PhaseScheduler();
+
+    /** Arm the timer kind of node id at time t (re-arming moves it); returns true if the bucket is new. */
+    bool schedule(int64_t t, int kind, int id);
+    /** Disarm the timer kind of node id, if pending. */
+    void cancel(int kind, int id);
+    bool isScheduled(int kind, int id) const;
+    /** Remove bucket (t, kind) and append the nodes whose timer is still armed, in scheduling order. */
+    void take(int64_t t, int kind, std::vector<int> &ids);
+
+    unsigned long getFired() const { return fired; }
+    /** Timers dispatched without an FES event of their own. */
+    unsigned long getCoalesced() const { return fired - wakes; }
+};
+
+#endif
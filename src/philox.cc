@@ -0,0 +1,65 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <cmath>
+#include "philox.h"
+
+static inline void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo)
+{
+    uint64_t p = (uint64_t) a * b;
+    hi = (uint32_t) (p >> 32);
+    lo = (uint32_t) p;
+}
+
+void CounterRNG::block(uint32_t node, uint32_t round, uint32_t purpose, uint32_t index, uint32_t out[4]) const
+{
+    uint32_t c0 = node, c1 = round, c2 = purpose, c3 = index;
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int i = 0; i < 10; i++) {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(0xD2511F53, c0, hi0, lo0);
+        mulhilo(0xCD9E8D57, c2, hi1, lo1);
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+double CounterRNG::uniform01(int node, unsigned int round, int purpose, unsigned int index) const
+{
+    uint32_t r[4];
+    block(node, round, purpose, index, r);
+    return ((r[0] >> 5) * 67108864.0 + (r[1] >> 6)) * (1.0 / 9007199254740992.0);
+}
+
+int CounterRNG::intuniform(int a, int b, int node, unsigned int round, int purpose, unsigned int index) const
+{
+    return a + (int) floor(uniform01(node, round, purpose, index) * ((double) b - a + 1));
+}
+
+uint32_t CounterRNG::bits32(int node, unsigned int round, int purpose, unsigned int index) const
+{
+    uint32_t r[4];
+    block(node, round, purpose, index, r);
+    return r[0];
+}
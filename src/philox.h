@@ -0,0 +1,56 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_PHILOX_H_
+#define __IMPRO_LEACH_PHILOX_H_
+
+#include <cstdint>
+
+/**
+ * Counter-based random numbers (Philox4x32-10): a draw is a pure function of
+ * (seed, node, round, purpose, index), so draws can be made in any order and
+ * give the same numbers in every execution mode (Sensor modules, SensorField,
+ * PSweep), independently of the order of the events.
+ */
+class CounterRNG
+{
+  private:
+    uint32_t key[2];
+
+  public:
+    // what a draw is used for: draws of different purposes never collide
+    enum purpose {
+        ELECTION,       // T(n) draw of a node in a round
+        PLACEMENT,      // position of a node (round: attempt, index 0: x, 1: y)
+        ELECTION_ENGINE,// draws of the BS election engine (node: draw number)
+        CLUSTERING,     // seeds of the LEACH-C annealing chains (node: chain)
+        MOBILITY        // waypoints and speeds of a node (round: draw number)
+    };
+
+    CounterRNG(uint64_t seed = 0) { setSeed(seed); }
+    void setSeed(uint64_t seed) { key[0] = (uint32_t) seed; key[1] = (uint32_t) (seed >> 32); }
+
+    /** The 128 random bits of counter (node, round, purpose, index). */
+    void block(uint32_t node, uint32_t round, uint32_t purpose, uint32_t index, uint32_t out[4]) const;
+
+    /** Uniform in [0,1), 53 bits. */
+    double uniform01(int node, unsigned int round, int purpose, unsigned int index = 0) const;
+    /** Uniform integer in [a,b]. */
+    int intuniform(int a, int b, int node, unsigned int round, int purpose, unsigned int index = 0) const;
+    uint32_t bits32(int node, unsigned int round, int purpose, unsigned int index = 0) const;
+};
+
+#endif
@@ -0,0 +1,103 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include "proxy.h"
+
+Define_Module(Proxy);
+
+void Proxy::initialize()
+{
+    N = getParentModule()->par("Nnodes");
+    Np = getParentModule()->par("Npartitions");
+    partition = getIndex();
+    lookahead = par("lookahead");
+
+    // local nodes are the ones connected to us
+    localIds.resize(gateSize("out"));
+    for (int k = 0; k < gateSize("out"); k++) {
+        cModule *mod = gate("out", k)->getPathEndGate()->getOwnerModule();
+        int id = mod->isVector() ? mod->getIndex() : BS_ID;
+        localIds[k] = id;
+        localGate[id] = k;
+        if (partitionOf(id, N, Np) != partition)
+            throw cRuntimeError("node %d is connected to proxy[%d], but belongs to partition %d", id, partition, partitionOf(id, N, Np));
+    }
+}
+
+void Proxy::handleMessage(cMessage *msg)
+{
+    int dest = msg->par("dest").longValue();
+    bool fromRemote = msg->getArrivalGate()->isName("remoteIn");
+    // messages from another proxy have already spent their delay on the link
+    double delay = fromRemote ? 0 : msg->par("delay").doubleValue();
+    int source = fromRemote ? -1 : msg->getArrivalGate()->getIndex();
+
+    if (dest == BROADCAST_ID) {
+        // every other sensor of the network
+        if (!fromRemote)
+            for (unsigned int p = 0; p < Np; p++)
+                if (p != partition) forward(msg->dup(), p, delay);
+        deliverLocal(msg, dest, delay, source);
+    }
+    else if (dest == MULTICAST_ID) {
+        // the members of a TDMA table: one copy per partition involved
+        mScheduleTable *SCHED = check_and_cast<mScheduleTable *>(msg);
+        std::vector<bool> remote(Np, false);
+        for (unsigned int i = 0; i < SCHED->getMembersArraySize(); i++) {
+            int member = SCHED->getMembers(i);
+            unsigned int p = partitionOf(member, N, Np);
+            if (p != partition) remote[p] = true;
+            else if (localGate.count(member)) sendDelayed(msg->dup(), delay, "out", localGate[member]);
+        }
+        if (!fromRemote)
+            for (unsigned int p = 0; p < Np; p++)
+                if (remote[p]) forward(msg->dup(), p, delay);
+        delete msg;
+    }
+    else {
+        unsigned int p = partitionOf(dest, N, Np);
+        if (p == partition)
+            deliverLocal(msg, dest, delay, -1);
+        else if (!fromRemote)
+            forward(msg, p, delay);
+        else
+            throw cRuntimeError("message for node %d reached the wrong partition (%d)", dest, partition);
+    }
+}
+
+void Proxy::deliverLocal(cMessage *msg, int dest, double delay, int exclude)
+{
+    if (dest == BROADCAST_ID) {
+        for (unsigned int k = 0; k < localIds.size(); k++)
+            if ((int) k != exclude && localIds[k] != BS_ID)
+                sendDelayed(msg->dup(), delay, "out", k);
+        delete msg;
+    }
+    else {
+        std::map<int, int>::iterator it = localGate.find(dest);
+        if (it == localGate.end())
+            throw cRuntimeError("node %d is not connected to proxy[%d]", dest, partition);
+        sendDelayed(msg, delay, "out", it->second);
+    }
+}
+
+void Proxy::forward(cMessage *msg, unsigned int p, double delay)
+{
+    // the link to the other proxy takes the lookahead: we can't be faster than that
+    if (delay < lookahead)
+        throw cRuntimeError("%s has a delay of %g s, below the lookahead (%g s): check the bitrate of the nodes", msg->getName(), delay, lookahead);
+    sendDelayed(msg, delay - lookahead, "remoteOut", p);
+}
@@ -0,0 +1,52 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_PROXY_H_
+#define __IMPRO_LEACH_PROXY_H_
+
+#include <vector>
+#include <map>
+#include <omnetpp.h>
+#include "common.h"
+
+using namespace omnetpp;
+
+/**
+ * Message hub of one partition: delivers what the local nodes transmit,
+ * either to local nodes or to the proxy of the destination partition.
+ * Every message carries two parameters set by the sender: "dest"
+ * (node id, BS_ID, BROADCAST_ID or MULTICAST_ID) and "delay", its
+ * propagation delay; links between proxies take lookahead of it.
+ */
+class Proxy : public cSimpleModule
+{
+  private:
+    unsigned int N;             // nodes in the network
+    unsigned int Np;            // partitions
+    unsigned int partition;     // own partition (proxy index)
+    double lookahead;
+
+    std::map<int, int> localGate;   // node id -> index of out[]
+    std::vector<int> localIds;      // index of out[] -> node id
+
+  protected:
+    virtual void initialize();
+    virtual void handleMessage(cMessage *msg);
+    virtual void deliverLocal(cMessage *msg, int dest, double delay, int exclude);
+    virtual void forward(cMessage *msg, unsigned int p, double delay);
+};
+
+#endif
@@ -0,0 +1,116 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <sstream>
+#include <unordered_set>
+#include "psweep.h"
+#include "topology.h"
+#include "common.h"
+
+Define_Module(PSweep);
+
+void PSweep::initialize()
+{
+    cModule *net = getParentModule();
+    unsigned int N = net->par("Nnodes");
+    double edge = net->par("edge");
+    double range = sqrt(2*pow(edge,2));
+    counterRNG = net->par("counterRNG");
+    crng.setSeed(net->par("rngSeed").intValue());
+
+    std::istringstream Ps(par("Ps").stdstringValue());
+    double p;
+    while (Ps >> p) P.push_back(p);
+    if (P.empty())
+        throw cRuntimeError("no values of P in the Ps parameter");
+
+    // initial energy, then positions, drawn like the Sensor modules do
+    std::vector<double> energy(N);
+    for (unsigned int n = 0; n < N; n++)
+        energy[n] = par("energy");
+    std::vector<int> x(N), y(N);
+    std::string topologyFile = net->par("topologyFile").stdstringValue();
+    if (!topologyFile.empty()) {
+        const Topology *topology = Topology::get(topologyFile);
+        if (!topology)
+            throw cRuntimeError("can't read topology file %s", topologyFile.c_str());
+        if (topology->size() != N || topology->getEdge() != (int) edge)
+            throw cRuntimeError("topology file %s has %d nodes on a %d m edge, the network %d nodes on a %g m edge",
+                    topologyFile.c_str(), topology->size(), topology->getEdge(), N, edge);
+        for (unsigned int n = 0; n < N; n++) {
+            x[n] = topology->x(n);
+            y[n] = topology->y(n);
+            if (topology->hasEnergy()) energy[n] = topology->getEnergy(n);
+        }
+    }
+    else {
+        int minX = net->par("minX"), minY = net->par("minY");
+        std::unordered_set<long long> taken;
+        taken.insert(0);
+        for (unsigned int n = 0; n < N; n++) {
+            long long key;
+            unsigned int attempt = 0;
+            do {
+                if (counterRNG) {
+                    x[n] = crng.intuniform(minX, net->par("edge"), n, attempt, CounterRNG::PLACEMENT, 0);
+                    y[n] = crng.intuniform(minY, net->par("edge"), n, attempt, CounterRNG::PLACEMENT, 1);
+                    attempt++;
+                }
+                else {
+                    x[n] = intuniform(minX, net->par("edge"));
+                    y[n] = intuniform(minY, net->par("edge"));
+                }
+                key = ((long long) (unsigned int) x[n] << 32) | (unsigned int) y[n];
+            } while (taken.count(key));
+            taken.insert(key);
+        }
+    }
+
+    RadioModel radio;
+    radio.setup(par("Eelec"), par("Eamp"), par("Emp"), par("gamma"), par("d0"));
+    engine.setup(P, x, y, energy, radio, range, par("Ecomp"));
+    rounds = 0;
+
+    scheduleAt(0, new cMessage("sweep", START_ROUND));
+}
+
+void PSweep::handleMessage(cMessage *msg)
+{
+    // the whole sweep in one event: rounds have no timing in this model
+    unsigned int N = getParentModule()->par("Nnodes");
+    int maxRounds = par("maxRounds");
+    std::vector<double> u(N);
+    while (!engine.over() && (maxRounds < 0 || rounds < maxRounds)) {
+        for (unsigned int n = 0; n < N; n++)
+            u[n] = counterRNG ? crng.uniform01(n, rounds, CounterRNG::ELECTION) : uniform(0,1);
+        engine.round(rounds, u);
+        rounds++;
+    }
+    delete msg;
+}
+
+void PSweep::finish()
+{
+    recordScalar("rounds", rounds);
+    for (unsigned int v = 0; v < engine.variants(); v++) {
+        std::ostringstream name;
+        name << "P=" << P[v] << " ";
+        recordScalar((name.str() + "firstNodeDead").c_str(), engine.getFirstDead(v));
+        recordScalar((name.str() + "halfNodesDead").c_str(), engine.getHalfDead(v));
+        recordScalar((name.str() + "lastNodeDead").c_str(), engine.getLastDead(v));
+        recordScalar((name.str() + "alive").c_str(), engine.getAlive(v));
+    }
+}
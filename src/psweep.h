@@ -0,0 +1,46 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_PSWEEP_H_
+#define __IMPRO_LEACH_PSWEEP_H_
+
+#include <omnetpp.h>
+#include "sweep.h"
+#include "philox.h"
+
+using namespace omnetpp;
+
+/**
+ * Runs the round-level LEACH model of SweepEngine for all the values of P
+ * of the "Ps" parameter at once (see Sweep_net), and records the lifetime
+ * of the network for each of them.
+ */
+class PSweep : public cSimpleModule
+{
+  private:
+    std::vector<double> P;
+    SweepEngine engine;
+    int rounds;             // rounds run
+    bool counterRNG;        // same draws as the Sensor modules with counterRNG
+    CounterRNG crng;
+
+  protected:
+    virtual void initialize();
+    virtual void handleMessage(cMessage *msg);
+    virtual void finish();
+};
+
+#endif
@@ -0,0 +1,59 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <cmath>
+#include "radio.h"
+
+RadioModel::RadioModel()
+{
+    setup(0, 0, 0, 2, 0);
+}
+
+void RadioModel::setup(double Eelec, double Efs, double Emp, double gamma, double d0)
+{
+    this->Eelec = Eelec;
+    this->Efs = Efs;
+    this->gamma = gamma;
+    this->d0 = d0;
+
+    // a negative Emp keeps the cost continuous at d0 (with gamma = 2 this is the plain d^2 model)
+    this->Emp = (Emp < 0) ? Efs * pow(d0, 2 - gamma) : Emp;
+
+    if (gamma == 2 || gamma == 3 || gamma == 4)
+        gammaInt = (int) gamma;
+    else
+        gammaInt = 0;
+}
+
+RadioLink RadioModel::link(double d) const
+{
+    RadioLink l;
+    double d2 = d * d;
+
+    if (d < d0) {
+        l.coef = Efs;
+        l.loss = d2;
+        return l;
+    }
+
+    l.coef = Emp;
+    switch (gammaInt) {
+        case 2: l.loss = d2; break;
+        case 3: l.loss = d2 * d; break;
+        case 4: l.loss = d2 * d2; break;
+        default: l.loss = exp(gamma * log(d)); break;
+    }
+    return l;
+}
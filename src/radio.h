@@ -0,0 +1,59 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_RADIO_H_
+#define __IMPRO_LEACH_RADIO_H_
+
+/**
+ * Amplifier cost of a link, computed once for a given distance.
+ * TX cost of k bits is Eelec*k + coef*k*loss.
+ */
+struct RadioLink
+{
+    double coef;    // amplifier energy (J/bit/m^2 or J/bit/m^gamma)
+    double loss;    // d^2 (free space) or d^gamma (multipath)
+};
+
+/**
+ * First-order radio model: free space (d^2) below the crossover distance d0,
+ * multipath (d^gamma) above it.
+ */
+class RadioModel
+{
+  private:
+    double Eelec;   // energy dissipation for radio operations (J/bit)
+    double Efs;     // free space amplifier (J/bit/m^2)
+    double Emp;     // multipath amplifier (J/bit/m^gamma)
+    double gamma;   // path loss exponent above d0
+    double d0;      // crossover distance (m)
+    int gammaInt;   // gamma if it is 2, 3 or 4 (no pow() needed), 0 otherwise
+
+  public:
+    RadioModel();
+    void setup(double Eelec, double Efs, double Emp, double gamma, double d0);
+
+    RadioLink link(double d) const;
+
+    // energy consumption to transmit k bit over a precomputed link
+    double TX(unsigned int k, const RadioLink &l) const { return (Eelec * k) + l.coef * k * l.loss; }
+    // energy consumption to transmit k bit at distance d
+    double TX(unsigned int k, double d) const { return TX(k, link(d)); }
+    // energy consumption to receive k bit
+    double RX(unsigned int k) const { return Eelec * k; }
+
+    double getCrossover() const { return d0; }
+};
+
+#endif
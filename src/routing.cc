@@ -0,0 +1,147 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <cmath>
+#include <algorithm>
+#include "routing.h"
+#include "common.h"
+
+CHRouter::CHRouter()
+{
+    Eelec = 0;
+    bsX = bsY = 0;
+    dirty = false;
+    rebuilds = 0;
+}
+
+void CHRouter::setup(unsigned int capacity, double minX, double minY, double maxX, double maxY, double cell,
+        const RadioModel &radio, double bsX, double bsY)
+{
+    grid.setup(capacity, minX, minY, maxX, maxY, cell);
+    this->radio = radio;
+    Eelec = radio.RX(1);
+    this->bsX = bsX;
+    this->bsY = bsY;
+
+    heads.clear();
+    slot.assign(capacity, -1);
+    parent.assign(capacity, BS_ID);
+    hop.assign(capacity, 0);
+    cost.assign(capacity, 0);
+    dirty = true;
+}
+
+double CHRouter::amplifier(double d) const
+{
+    RadioLink l = radio.link(d);
+    return l.coef * l.loss;
+}
+
+void CHRouter::addCH(int id, double x, double y)
+{
+    if (slot[id] >= 0) return;
+    slot[id] = heads.size();
+    heads.push_back(id);
+    grid.insert(id, x, y);
+    dirty = true;
+}
+
+void CHRouter::removeCH(int id)
+{
+    if (slot[id] < 0) return;
+    int last = heads.back();
+    heads[slot[id]] = last;
+    slot[last] = slot[id];
+    heads.pop_back();
+    slot[id] = -1;
+    grid.remove(id);
+    dirty = true;
+}
+
+void CHRouter::moveCH(int id, double x, double y)
+{
+    if (slot[id] < 0) return;
+    grid.move(id, x, y);
+    dirty = true;
+}
+
+void CHRouter::rebuild()
+{
+    std::vector<std::pair<double, int> > order(heads.size());
+    for (unsigned int i = 0; i < heads.size(); i++) {
+        int id = heads[i];
+        order[i].first = sqrt(pow(grid.getX(id) - bsX, 2) + pow(grid.getY(id) - bsY, 2));
+        order[i].second = id;
+    }
+    std::sort(order.begin(), order.end());
+
+    // a CH may only relay through CHs already visited (closer to the BS): the tree is acyclic
+    std::vector<char> visited(slot.size(), 0);
+    const double cellSize = grid.getCell();
+
+    for (unsigned int i = 0; i < order.size(); i++) {
+        int id = order[i].second;
+        double x = grid.getX(id);
+        double y = grid.getY(id);
+
+        // direct transmission to the BS
+        double best = Eelec + amplifier(order[i].first);
+        int bestHop = BS_ID;
+        double bestDist = order[i].first;
+
+        int cx = grid.cellX(x);
+        int cy = grid.cellY(y);
+        for (int k = 0; ; k++) {
+            // any CH in ring k is at least (k-1) cells away: TX + RX of the relay already cost more
+            double bound = (k > 0) ? (k - 1) * cellSize : 0;
+            if (2*Eelec + amplifier(bound) >= best) break;
+
+            bool inside = grid.forRing(cx, cy, k, [&](int j) {
+                if (!visited[j]) return;
+                double d = sqrt(pow(grid.getX(j) - x, 2) + pow(grid.getY(j) - y, 2));
+                double c = Eelec + amplifier(d) + Eelec + cost[j];
+                if (c < best) {
+                    best = c;
+                    bestHop = j;
+                    bestDist = d;
+                }
+            });
+            if (!inside) break;
+        }
+
+        parent[id] = bestHop;
+        hop[id] = bestDist;
+        cost[id] = best;
+        visited[id] = 1;
+    }
+
+    dirty = false;
+    rebuilds++;
+}
+
+int CHRouter::nextHop(int id)
+{
+    if (dirty) rebuild();
+    return (slot[id] >= 0) ? parent[id] : BS_ID;
+}
+
+double CHRouter::hopDistance(int id)
+{
+    if (dirty) rebuild();
+    if (slot[id] >= 0)
+        return hop[id];
+    // not a CH (anymore): straight to the BS
+    return sqrt(pow(grid.getX(id) - bsX, 2) + pow(grid.getY(id) - bsY, 2));
+}
@@ -0,0 +1,65 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __IMPRO_LEACH_ROUTING_H_
+#define __IMPRO_LEACH_ROUTING_H_
+
+#include <vector>
+#include "grid.h"
+#include "radio.h"
+
+/**
+ * Minimum-energy tree of the current CHs towards the BS (multi-hop mode).
+ * CHs are kept in a spatial grid, updated as nodes take or leave the CH role.
+ * The tree is recomputed lazily (at the first query after a change): CHs are visited
+ * by increasing distance from the BS and each one picks, among the already visited CHs
+ * and the BS itself, the next hop with the cheapest path cost per bit. The ring search
+ * in the grid stops as soon as a farther candidate cannot beat the best one.
+ */
+class CHRouter
+{
+  private:
+    SpatialGrid grid;
+    RadioModel radio;
+    double Eelec;
+    double bsX, bsY;
+
+    std::vector<int> heads;     // current CHs
+    std::vector<int> slot;      // position of a node inside heads (-1 if not CH)
+
+    std::vector<int> parent;    // next hop (BS_ID for the BS)
+    std::vector<double> hop;    // distance to the next hop
+    std::vector<double> cost;   // energy per bit of the path to the BS
+    bool dirty;
+    unsigned int rebuilds;
+
+    double amplifier(double d) const;
+    void rebuild();
+
+  public:
+    CHRouter();
+    void setup(unsigned int capacity, double minX, double minY, double maxX, double maxY, double cell,
+            const RadioModel &radio, double bsX, double bsY);
+
+    void addCH(int id, double x, double y);
+    void removeCH(int id);
+    void moveCH(int id, double x, double y);
+
+    int nextHop(int id);            // BS_ID if the BS is the next hop
+    double hopDistance(int id);
+    unsigned int getRebuilds() const { return rebuilds; }
+};
+
+#endif
@@ -14,6 +14,8 @@
 // 
 
 #include "sensor.h"
+#include "topology.h"
+#include "BS.h"
 
 Define_Module(Sensor);
 
@@ -23,6 +25,18 @@ void Sensor::initialize()
     P = getParentModule()->par("P");
     id = this->getIndex(); // return the index of current module
     N = getParentModule()->par("Nnodes");
+    centralized = getParentModule()->par("centralized");
+    multiHop = getParentModule()->par("multiHop");
+    electionEngine = getParentModule()->par("electionEngine");
+    roundTick = getParentModule()->par("roundTick");
+    phaseBuckets = getParentModule()->par("phaseBuckets");
+    counterRNG = getParentModule()->par("counterRNG");
+    crng.setSeed(getParentModule()->par("rngSeed").intValue());
+    partitioned = getParentModule()->par("partitioned");
+    if (partitioned && getParentModule()->par("energyLedger").boolValue())
+        throw cRuntimeError("energyLedger needs the BS in the same partition: it can't be used on a partitioned network");
+    if (partitioned && (centralized || multiHop || electionEngine || roundTick || phaseBuckets || par("DistAwareCH").boolValue() || par("EnergyAwareCH").boolValue()))
+        throw cRuntimeError("centralized, multiHop, electionEngine, roundTick, phaseBuckets, DistAwareCH and EnergyAwareCH need the state of other nodes: they can't be used on a partitioned network");
 
     double edge = getParentModule()->par("edge");
     range = sqrt(2*pow(edge,2));
@@ -33,11 +47,16 @@ void Sensor::initialize()
     Eamp = this->par("Eamp");
     Ecomp = this->par("Ecomp");
     gamma = this->par("gamma");
+    Emp = this->par("Emp");
+    d0 = this->par("d0");
+    radio.setup(Eelec, Eamp, Emp, gamma, d0);
 
     energy = this->par("energy");
     WATCH(energy);
 
     BS = getParentModule()->getSubmodule("baseStation");
+    // on a partitioned network the BS may live in another process: only talk to it by messages
+    BSstate = partitioned ? nullptr : check_and_cast< ::BS *>(BS);
 
     // setup internal events
     startRound_e = new cMessage("start-round", START_ROUND);
@@ -49,28 +68,79 @@ void Sensor::initialize()
 
 
     // Setup position
-    bool noRepeatPos = true;
-    do{
-        noRepeatPos = true;
-        x = intuniform(getParentModule()->par("minX"), getParentModule()->par("edge"));
-        y = intuniform(getParentModule()->par("minY"), getParentModule()->par("edge"));
-        // check that no other nodes has the same coordinates
-        for(unsigned int n = 0; n < N; n++){
-           cModule * mod = retrieveNode(n);
-           unsigned int modx = mod->par("posX");
-           unsigned int mody = mod->par("posY");
-           if((modx == x) && (mody == y)){
-               noRepeatPos = false;
-           }
+    int minX = getParentModule()->par("minX");
+    int maxX = getParentModule()->par("edge");
+    unsigned int Np = 1, partition = 0;
+    if (partitioned) {
+        // each partition gets its own vertical strip of the field,
+        // so that positions only have to be checked against local nodes
+        Np = getParentModule()->par("Npartitions");
+        partition = partitionOf(id, N, Np);
+        int width = maxX - minX + 1;
+        maxX = minX + (width * (partition + 1)) / Np - 1;
+        minX = minX + (width * partition) / Np;
+    }
+    std::string topologyFile = getParentModule()->par("topologyFile").stdstringValue();
+    if (!topologyFile.empty()) {
+        // same deployment as the other runs on this file, no draws
+        const Topology *topology = Topology::get(topologyFile);
+        if (!topology)
+            throw cRuntimeError("can't read topology file %s", topologyFile.c_str());
+        if (topology->size() != N || topology->getEdge() != (int) edge)
+            throw cRuntimeError("topology file %s has %d nodes on a %d m edge, the network %d nodes on a %g m edge",
+                    topologyFile.c_str(), topology->size(), topology->getEdge(), N, edge);
+        x = topology->x(id);
+        y = topology->y(id);
+        if (topology->hasEnergy()) {
+            energy = topology->getEnergy(id);
+            this->par("energy") = energy; // initial energy, as seen by EnergyAwareCH
         }
-    }while((!noRepeatPos));
+    }
+    else {
+        bool noRepeatPos = true;
+        unsigned int attempt = 0;
+        do{
+            noRepeatPos = true;
+            if (counterRNG) {
+                x = crng.intuniform(minX, maxX, id, attempt, CounterRNG::PLACEMENT, 0);
+                y = crng.intuniform(getParentModule()->par("minY"), getParentModule()->par("edge"), id, attempt, CounterRNG::PLACEMENT, 1);
+                attempt++;
+            }
+            else {
+                x = intuniform(minX, maxX);
+                y = intuniform(getParentModule()->par("minY"), getParentModule()->par("edge"));
+            }
+            // check that no other nodes has the same coordinates
+            for(unsigned int n = 0; n < N; n++){
+               if (partitioned && partitionOf(n, N, Np) != partition) continue;
+               cModule * mod = retrieveNode(n);
+               unsigned int modx = mod->par("posX");
+               unsigned int mody = mod->par("posY");
+               if((modx == x) && (mody == y)){
+                   noRepeatPos = false;
+               }
+            }
+        }while((!noRepeatPos));
+    }
     // update parameters
     this->par("posX") = x;
     this->par("posY") = y;
 
+    // amplifier costs that do not change during the simulation (unless we move)
+    if (!partitioned) ::BS::collectSinks(getParentModule(), sinks);
+    locateSink();
+    maxLink = radio.link(MAX_DIST(range));
+
     energySignal = registerSignal("energy");
 
-    scheduleAt(0,startRound_e);
+    // the last Nspares nodes are spares: placed, but only deployed by the BS later on (see revive)
+    if (id >= N - (unsigned int) getParentModule()->par("Nspares").intValue()) {
+        role = DEAD;
+        return;
+    }
+
+    if (!roundTick)
+        scheduleTimer(0, startRound_e);
 }
 
 void Sensor::finish()
@@ -85,14 +155,15 @@ void Sensor::finish()
 void Sensor::reset()
 {
     getDisplayString().setTagArg("i", 0, "old/ball"); // UI feedback
-    role = SENSOR;
-    msgBuf.clear();
+    setRole(SENSOR);
+    members.open(par("round"));
     CH_id = -1;         // Cluster-Head id
+    CH_dist = std::numeric_limits<double>::infinity();
     clusterN = 0;  // used by CH to keep track of the num. of nodes in the cluster
-    cancelEvent(rcvdADV_e);
-    cancelEvent(rcvdJoin_e);
-    cancelEvent(rcvdData_e);
-    cancelEvent(startTX_e);
+    cancelTimer(rcvdADV_e);
+    cancelTimer(rcvdJoin_e);
+    cancelTimer(rcvdData_e);
+    cancelTimer(startTX_e);
 
 }
 
@@ -106,13 +177,15 @@ void Sensor::handleMessage(cMessage *msg)
                 // start a new round in LEACH
                 selfElection(); // new election
                 // schedule the next round after roundTime
-                scheduleAt(simTime()+roundTime,startRound_e);
+                scheduleTimer(simTime()+roundTime, startRound_e);
                 break;
 
             /******** Non-CH cases *********/
             case ADV_M:
                 if(role == SENSOR)
-                    msgBuf.push_back(msg); // insert ADV into the message buffer
+                    handleADV((mAdvertisement *) msg); // keep track of the nearest CH so far
+                else
+                    cancelAndDelete(msg);
                 break;
 
             case RCVD_ADV:
@@ -121,8 +194,12 @@ void Sensor::handleMessage(cMessage *msg)
                 break;
 
             case SCHED_M:
-                // setup data send interval
-                setupDataTX((mSchedule *) msg);
+                if(msg->isSelfMessage())
+                    // TDMA table of our cluster is on air: every member reads its own turn
+                    dispatchSchedule((mScheduleTable *) msg);
+                else
+                    // partitioned network: our copy of the table of our CH
+                    readSchedule((mScheduleTable *) msg);
                 break;
 
             case START_TX:
@@ -131,12 +208,13 @@ void Sensor::handleMessage(cMessage *msg)
 
             /******** CH cases *********/
             case JOIN_M:
-                msgBuf.push_back(msg); // insert JOIN into the message buffer
+                members.add(((mJoin *) msg)->getId(), ((mJoin *) msg)->getRound()); // only the id is needed
+                cancelAndDelete(msg);
                 break;
 
             case RCVD_JOIN:
                 // wake up after timeout to check received ADVs
-                if(msgBuf.size() > 0)
+                if(members.size() > 0)
                     createTXSched();
                 else{
 
@@ -160,20 +238,35 @@ void Sensor::handleMessage(cMessage *msg)
 
             case CENTER_M:
                 //setup CH environment variables
-                alreadyCH = true;   // node excludes itself from next election
-                role = CH;
+                setAlreadyCH(true);   // node excludes itself from next election
+                setRole(CH);
                 clusterN = ((mCenterCH *) msg)->getClusterN();
                 getDisplayString().setTagArg("i", 0, "old/ball2"); // UI feedback
                 // setup a timer to keep radio in IDLE mode and receive all data (TDMA)
                 // Timeout will take in account the propagation delay for SCHED msg to reach destination and to receive back all data sequentially
-                scheduleAt(simTime() + (((mCenterCH *) msg)->getSCHEDDelay()) + (((mCenterCH *) msg)->getIDLETime()) + EPSILON, rcvdData_e);
+                scheduleTimer(simTime() + (((mCenterCH *) msg)->getSCHEDDelay()) + (((mCenterCH *) msg)->getIDLETime()) + EPSILON, rcvdData_e);
                 #ifdef ACCOUNT_CH_SETUP
                 // account for energy during IDLE time
                 EnergyMgmt(RX, 0, clusterN*DATA_M_SIZE);
                 #endif
                 break;
 
+            /********** centralized clustering (LEACH-C) **************/
 
+            case ASSIGN_M:
+                handleAssignment((mAssign *) msg);
+                break;
+
+            /********** multi-hop inter-CH routing **************/
+
+            case RELAY_M:
+                // aggregate from a farther CH: receive it and pass it on
+                EnergyMgmt(RX, 0, DATA_M_SIZE);
+                if(role != DEAD)
+                    forwardAggregate((mRelay *) msg);
+                else
+                    cancelAndDelete(msg);
+                break;
 
         }
     }
@@ -184,8 +277,150 @@ void Sensor::handleMessage(cMessage *msg)
             // drop all the msg from other modules
             cancelAndDelete(msg);
         }
+        else if(msg->getKind() == SCHED_M){
+            // the schedule was already on air when we died
+            dispatchSchedule((mScheduleTable *) msg);
+        }
+    }
+
+}
+
+void Sensor::scheduleTimer(simtime_t t, cMessage *timer)
+{
+    if (phaseBuckets)
+        BSstate->schedulePhase(t, timer->getKind(), id); // shared with the same timers of the other nodes
+    else
+        scheduleAt(t, timer);
+}
+
+void Sensor::cancelTimer(cMessage *timer)
+{
+    if (phaseBuckets)
+        BSstate->cancelPhase(timer->getKind(), id);
+    else
+        cancelEvent(timer);
+}
+
+void Sensor::locateSink()
+{
+    // once, or when restored or moved
+    sink = BS;
+    if (partitioned)
+        sinkDist = BS_DIST(x,y); // other partitions only know where the BS is
+    else
+        sink = sinks[::BS::nearestSink(sinks, x, y, sinkDist)];
+#ifdef USE_BS_DIST
+    uplinkDist = sinkDist;
+#else
+    // with a single BS "far away" everybody pays the worst case, extra sinks are meant to be near
+    uplinkDist = (sinks.size() > 1) ? sinkDist : MAX_DIST(range);
+#endif
+    uplinkLink = radio.link(uplinkDist);
+}
+
+void Sensor::moveTo(int x, int y)
+{
+    // called by the BS (mobility): CH_dist follows lazily (see refreshCH)
+    Enter_Method_Silent();
+    this->x = x;
+    this->y = y;
+    this->par("posX") = x;
+    this->par("posY") = y;
+    locateSink();
+}
+
+void Sensor::stampCH()
+{
+    Mobility *mobility = BSstate ? BSstate->getMobility() : nullptr;
+    if (mobility && CH_id >= 0 && CH_id != BS_ID) {
+        CHStamp[0] = mobility->getStamp(id);
+        CHStamp[1] = mobility->getStamp(CH_id);
     }
+}
 
+void Sensor::refreshCH()
+{
+    // with mobility, CH_dist is stale if we or our CH moved since it was computed
+    Mobility *mobility = BSstate ? BSstate->getMobility() : nullptr;
+    if (!mobility || CH_id < 0) return;
+    if (CH_id == BS_ID) {
+        if (CH_dist != uplinkDist) setCH(BS_ID, uplinkDist); // kept up to date by moveTo()
+    }
+    else if (mobility->getStamp(id) != CHStamp[0] || mobility->getStamp(CH_id) != CHStamp[1])
+        setCH(CH_id, distance(CH_id));
+}
+
+void Sensor::trace(int kind, int arg)
+{
+    if (BSstate) BSstate->traceEvent(kind, id, arg); // the BS of a partitioned network may be elsewhere
+}
+
+void Sensor::fireTimer(short kind)
+{
+    // our bucket of timers expired (phaseBuckets mode)
+    Enter_Method_Silent();
+    switch(kind)
+    {
+        case START_ROUND: handleMessage(startRound_e); break;
+        case RCVD_ADV: handleMessage(rcvdADV_e); break;
+        case RCVD_JOIN: handleMessage(rcvdJoin_e); break;
+        case RCVD_DATA: handleMessage(rcvdData_e); break;
+        case START_TX: handleMessage(startTX_e); break;
+    }
+}
+
+void Sensor::restore(const NodeCheckpoint &state, int round)
+{
+    // called by the BS at initialize: continue from the end of the given round
+    Enter_Method_Silent();
+    x = state.x;
+    y = state.y;
+    this->par("posX") = x;
+    this->par("posY") = y;
+    locateSink();
+    energy = state.energy;
+    alreadyCH = state.alreadyCH;   // the election engine is restored by the BS
+    par("round") = round;
+    roundTime = getParentModule()->par("roundTime");
+    if (state.dead) {
+        setRole(DEAD);
+        getDisplayString().setTagArg("i2", 0, "old/x_cross");
+        cancelTimer(startRound_e);
+    }
+}
+
+void Sensor::revive(double battery, int round, simtime_t start)
+{
+    // called by the BS (maintenance): a new battery (battery < 0: like the first one).
+    // If we were dead, or a spare, we are back for the round at start
+    Enter_Method_Silent();
+    EnergyLedger *ledger = BSstate->getLedger();
+    if (ledger && ledger->owes(id)) ledger->take(id, owed); // the debts went away with the old battery
+    energy = (battery < 0) ? par("energy").doubleValue() : battery;
+    emit(energySignal, energy);
+    char buf[256];
+    sprintf(buf, "energy %.2f\n", energy);
+    getDisplayString().setTagArg("t", 0, buf);
+    if (role != DEAD) return; // the round goes on
+
+    par("round") = round;
+    roundTime = getParentModule()->par("roundTime");
+    reset();
+    cancelTimer(rcvdSCHED_e);
+    cancelTimer(startRound_e);
+    getDisplayString().setTagArg("i2", 0, "");
+    // T(n) counts on the nodes not CH yet shrinking by P*N every round of the epoch:
+    // a newcomer would be forced into the CH set at its end, so it waits for the next epoch
+    setAlreadyCH(true);
+    if (!roundTick)
+        scheduleTimer(start, startRound_e);
+}
+
+void Sensor::startRound()
+{
+    // called by the BS at every round (roundTick mode)
+    Enter_Method_Silent();
+    selfElection();
 }
 
 /******************* SENSOR functions **********************/
@@ -194,7 +429,7 @@ double Sensor::T(unsigned int n)    // T(n) threshold function
     unsigned int r = par("round"); // get current round
 
     if(!alreadyCH)
-        return P/(1-P*(r % 1/P));
+        return leachThreshold(P, r);
     else
         return 0;
 }
@@ -204,16 +439,34 @@ void Sensor::selfElection()
 
     unsigned int r = par("round"); // NOTE: par("round") starts at -1
     par("round") = r+1;
-    if ((r+1) == 0) roundTime = getParentModule()->par("roundTime");
+    if ((r+1) == 0){
+        if (partitioned) // the BS can't share it: same formula as BS::initialize()
+            roundTime = 1 + (N * propagationDelay(DATA_M_SIZE, MAX_DIST(range)));
+        else
+            roundTime = getParentModule()->par("roundTime");
+    }
     if(r+1 > 0) reset(); //reset all the structures before starting new round
 
+    if (centralized) return; // the BS will send the cluster assignment for this round
+
     r = par("round");
-    if((r % 1/P) == 0) alreadyCH = false; // reset current node status
+    if((r % leachEpoch(P)) == 0) alreadyCH = false; // reset current node status
 
-    //compute Threshold function
-    double th = T(id);
-    double chance = uniform(0,1);
-    if (chance < th)
+    bool elected;
+    if (electionEngine)
+    {
+        // the BS draws the CHs of the whole network at once
+        elected = BSstate->isElected(r, id);
+    }
+    else
+    {
+        //compute Threshold function
+        double th = T(id);
+        double chance = counterRNG ? crng.uniform01(id, r, CounterRNG::ELECTION) : uniform(0,1);
+        elected = (chance < th);
+    }
+
+    if (elected)
     {
         // self-elected as Cluster-Head (CH)
         //proceed to Advertisement Phase
@@ -224,7 +477,7 @@ void Sensor::selfElection()
     {
         // not CH.
         // start waiting for ADVs (consider max distance for timeout)
-        scheduleAt(simTime() + propagationDelay(ADV_M_SIZE, MAX_DIST(range))+EPSILON, rcvdADV_e);
+        scheduleTimer(simTime() + propagationDelay(ADV_M_SIZE, MAX_DIST(range))+EPSILON, rcvdADV_e);
 #ifdef ACCOUNT_CH_SETUP
         // add ENERGY CONSUMPTION FOR THE AMOUNT OF TIME WE ARE IN IDLE STATE
         EnergyMgmt(RX, 0, ADV_M_SIZE);
@@ -232,38 +485,41 @@ void Sensor::selfElection()
     }
 }
 
-void Sensor::chooseCH()
+void Sensor::handleADV(mAdvertisement *ADV)
 {
-    CH_dist = std::numeric_limits<double>::infinity();
-    CH_id = -1;
-
-    for(unsigned int i = 0; i < msgBuf.size(); i++){
-        mAdvertisement *ADV = (mAdvertisement *) msgBuf.at(i);
-        // check distance of sender
-        // use euclidean distance to simulate RSSI
-        double dist = distance(ADV->getId());
-        if(dist < CH_dist){
-            CH_dist = dist;
-            CH_id = ADV->getId(); // select CH based on distance/RSSI
-        }
-        EV << "ADV received from " << ADV->getId() << " distance is " << dist << "\n";
-        cancelAndDelete(ADV);
+    // check distance of sender
+    // use euclidean distance to simulate RSSI
+    double dx = x - ((double) ADV->getX());
+    double dy = y - ((double) ADV->getY());
+    double dist = sqrt( pow(dx,2) + pow(dy,2));
+    EV << "ADV received from " << ADV->getId() << " distance is " << dist << "\n";
+    if(dist < CH_dist){ // strict: on ties the first ADV received wins
+        CH_dist = dist;
+        CH_id = ADV->getId(); // select CH based on distance/RSSI
+        stampCH();
     }
+    cancelAndDelete(ADV);
+}
 
+void Sensor::chooseCH()
+{
+    // the nearest CH has already been selected while receiving the ADVs (see handleADV)
     if(CH_id > -1){
         // CH has been chosen
         EV << "CH designed is " << CH_id << "\n";
-        msgBuf.clear(); // empty the msg buffer
+        CHLink = radio.link(CH_dist);
+        refreshCH();
 
         double delay = propagationDelay(JOIN_M_SIZE, CH_dist);
         // notify CH
         mJoin *JOIN = new mJoin("join-cluster", JOIN_M);
         JOIN->setId(id);
-        cModule *CH = retrieveNode(CH_id);
-        sendDirect(JOIN, delay, 0, CH->gate("in"));
+        JOIN->setRound(par("round"));
+        transmit(JOIN, CH_id, delay);
+        trace(TraceRing::JOIN, CH_id);
 #ifdef ACCOUNT_CH_SETUP
         // account for energy transmission based on distance
-        EnergyMgmt(TX, CH_dist, JOIN_M_SIZE);
+        EnergyMgmtTX(CHLink, JOIN_M_SIZE);
 #endif
 
     } else {
@@ -277,58 +533,138 @@ void Sensor::chooseCH()
 
 void Sensor::initOrphan()
 {
-    // set BS as CH
-    CH_id = BS_ID;
-#ifdef USE_BS_DIST
-    CH_dist = BS_DIST(x,y);
-#else
-    CH_dist = MAX_DIST(range);
-#endif
+    // set BS (our nearest sink) as CH
+    setCH(BS_ID, uplinkDist);
     // notify the BS that we are going to join it's cluster
     mJoin *JOIN = new mJoin("join-cluster", JOIN_M);
     double delay = propagationDelay(JOIN_M_SIZE, CH_dist);
     JOIN->setId(id);
-    sendDirect(JOIN, delay, 0, BS->gate("in"));
+    JOIN->setRound(par("round"));
+    transmit(JOIN, BS_ID, delay);
+    trace(TraceRing::JOIN, BS_ID);
 #ifdef ACCOUNT_CH_SETUP
     // account for energy transmission based on distance
-    EnergyMgmt(TX, CH_dist, JOIN_M_SIZE);
+    EnergyMgmtTX(CHLink, JOIN_M_SIZE);
 #endif
 }
 
-void Sensor::setupDataTX(mSchedule *SCHED){
+void Sensor::setupDataTX(mScheduleTable *SCHED, unsigned int turn){
 
     unsigned int r = par("round");
     if(r == SCHED->getRound()){
 
         if(par("DistAwareCH")){
             if(CH_id != SCHED->getCHId()){
-                CH_id = SCHED->getCHId();   // re-set the CH information if a better one has been designed by original CH
-                CH_dist = distance(CH_id);
+                // re-set the CH information if a better one has been designed by original CH
+                setCH(SCHED->getCHId(), distance(SCHED->getCHId()));
             }
         }
 
         // setup transmission time as the slot duration times my turn
-        scheduleAt(simTime()+(SCHED->getDuration()*SCHED->getTurn()), startTX_e);
-        cancelAndDelete(SCHED);
+        scheduleTimer(simTime()+(SCHED->getDuration()*turn), startTX_e);
     }
+    else if (BSstate)
+        BSstate->traceAnomaly(TraceRing::STALE_SCHED, id);
 
 }
 
+void Sensor::receiveSchedule(mScheduleTable *SCHED, unsigned int turn)
+{
+    // called by the CH (or the BS) when its TDMA table reaches us
+    Enter_Method_Silent();
+    if(role != DEAD)
+        setupDataTX(SCHED, turn);
+}
+
+mScheduleTable *Sensor::buildSchedule(double slot, int CHId)
+{
+    // one table for the whole cluster, turns follow the JOIN order
+    mScheduleTable *SCHED = new mScheduleTable("schedule-table", SCHED_M);
+    SCHED->setDuration(slot);
+    SCHED->setRound(par("round"));
+    SCHED->setCHId(CHId);
+    SCHED->setMembersArraySize(members.size());
+    for(unsigned int i = 0; i < members.size(); i++)
+        SCHED->setMembers(i, members.at(i));
+    return SCHED;
+}
+
+void Sensor::postSchedule(mScheduleTable *SCHED, double delay)
+{
+    if(partitioned)
+        transmit(SCHED, MULTICAST_ID, delay); // the proxies deliver one copy to each member
+    else
+        scheduleAt(simTime()+delay, SCHED); // handed to the members when it's on air (see dispatchSchedule)
+}
+
+void Sensor::readSchedule(mScheduleTable *SCHED)
+{
+    // look for our turn in the table
+    for(unsigned int i = 0; i < SCHED->getMembersArraySize(); i++){
+        if(SCHED->getMembers(i) == (int) id){
+            setupDataTX(SCHED, i);
+            break;
+        }
+    }
+    cancelAndDelete(SCHED);
+}
+
+void Sensor::dispatchSchedule(mScheduleTable *SCHED)
+{
+    for(unsigned int i = 0; i < SCHED->getMembersArraySize(); i++){
+        int member = SCHED->getMembers(i);
+        if(member == id){
+            if(role != DEAD)
+                setupDataTX(SCHED, i);
+        }
+        else if(BSstate->isAlive(member)){ // skip members died after joining (their turn stays empty)
+            EV << "schedule reaches " << member << "\n";
+            BSstate->getNode(member)->receiveSchedule(SCHED, i);
+        }
+    }
+    cancelAndDelete(SCHED);
+}
+
+void Sensor::handleAssignment(mAssign *ASSIGN)
+{
+    unsigned int r = par("round");
+    if(r == ASSIGN->getRound()){
+        if(ASSIGN->getCHId() == (int) id){
+            // selected as CH by the BS
+            setAlreadyCH(true);
+            setRole(CH);
+            trace(TraceRing::ELECTION, 0);
+            clusterN = ASSIGN->getClusterN();
+            getDisplayString().setTagArg("i", 0, "old/ball2"); // UI feedback
+            // keep radio in IDLE mode for the whole TDMA frame, then compress and send to BS
+            scheduleTimer(simTime() + clusterN*ASSIGN->getDuration() + EPSILON, rcvdData_e);
+        }
+        else
+        {
+            if(ASSIGN->getCHId() == BS_ID)
+                setCH(BS_ID, uplinkDist);
+            else
+                setCH(ASSIGN->getCHId(), distance(ASSIGN->getCHId()));
+            trace(TraceRing::JOIN, CH_id);
+            // setup transmission time as the slot duration times my turn
+            scheduleTimer(simTime()+(ASSIGN->getDuration()*ASSIGN->getTurn()), startTX_e);
+        }
+    }
+    cancelAndDelete(ASSIGN);
+}
+
 void Sensor::sendData(){
     mData *DATA = new mData("data", DATA_M);
     DATA->setId(id);
     DATA->setRound(par("round"));
+    refreshCH();
     if(CH_id > -1){
         // if node has CH
         double delay = propagationDelay(DATA_M_SIZE, CH_dist);
-        cModule *CH;
-        if(CH_id != BS_ID)
-            CH = retrieveNode(CH_id);
-        else
-            CH = BS;
-        sendDirect(DATA, delay, 0, CH->gate("in"));
+        transmit(DATA, CH_id, delay); // if the CH died meanwhile, the transmission is lost, but still paid
+        trace(TraceRing::DATA, CH_id);
         // ACCOUNT FOR DATA TRANSMISSION
-        EnergyMgmt(TX, CH_dist, DATA_M_SIZE);
+        EnergyMgmtTX(CHLink, DATA_M_SIZE);
 
 #ifndef ONE_TX_PER_ROUND
         // setup a timeout to receive a SCHED message for the next transmission
@@ -342,7 +678,7 @@ void Sensor::sendData(){
         // if node doesn't have CH, just send directly to BS
         double delay = propagationDelay(DATA_M_SIZE, MAX_DIST(range));
         EnergyMgmt(TX, MAX_DIST(range), DATA_M_SIZE);
-        scheduleAt(simTime()+delay, startTX_e); // schedule next autonomous send
+        scheduleTimer(simTime()+delay, startTX_e); // schedule next autonomous send
 
     }*/
 }
@@ -353,25 +689,39 @@ void Sensor::broadcastADV()
 {
     double ADV_delay = propagationDelay(ADV_M_SIZE, MAX_DIST(range)); // we consider maximum distance to reach all possible nodes
 
-    for(unsigned int n = 0; n < N; n++){
-        if(n != id){
-            cModule * sensor = retrieveNode(n);
-            mAdvertisement *ADV = new mAdvertisement("CH_advertisement", ADV_M);
-            ADV->setId(id);
-            sendDirect(ADV, ADV_delay, 0,  sensor->gate("in"));
+    if(partitioned){
+        // one copy per partition, the proxies deliver it to every sensor
+        mAdvertisement *ADV = new mAdvertisement("CH_advertisement", ADV_M);
+        ADV->setId(id);
+        ADV->setX(x);
+        ADV->setY(y);
+        transmit(ADV, BROADCAST_ID, ADV_delay);
+    }
+    else
+    {
+        // dead nodes would just drop it: only reach the alive ones
+        const std::vector<int> &alive = BSstate->getAlive()->list();
+        for(unsigned int i = 0; i < alive.size(); i++){
+            if(alive[i] != id){
+                mAdvertisement *ADV = new mAdvertisement("CH_advertisement", ADV_M);
+                ADV->setId(id);
+                ADV->setX(x);
+                ADV->setY(y);
+                sendDirect(ADV, ADV_delay, 0,  BSstate->getNode(alive[i])->gate("in"));
+            }
         }
     }
 
 #ifdef ACCOUNT_CH_SETUP
     // in this case, we consider an amount of energy to send a signal that
     // covers the entire sensed area
-    EnergyMgmt(TX, MAX_DIST(range), ADV_M_SIZE);
+    EnergyMgmtTX(maxLink, ADV_M_SIZE);
 #endif
     // set a timeout to receive JOIN messages
     // we consider a timeout equal to the maximum distance (i.e. range*2) propagation delay for both ADV to reach sensors
     // and for the JOIN msg to reach back at CH
     double JOIN_delay = propagationDelay(JOIN_M_SIZE, MAX_DIST(range));
-    scheduleAt(simTime() + ADV_delay+JOIN_delay+EPSILON, rcvdJoin_e);
+    scheduleTimer(simTime() + ADV_delay+JOIN_delay+EPSILON, rcvdJoin_e);
 
 #ifdef ACCOUNT_CH_SETUP
     // ACCOUNT FOR ENERGY SPENT WHILE IN IDLE STATE to receive JOIN messages
@@ -383,8 +733,9 @@ void Sensor::broadcastADV()
 
 void Sensor::advertisementPhase()
 {
-    alreadyCH = true;   // node excludes itself from next election
-    role = CH;
+    setAlreadyCH(true);   // node excludes itself from next election
+    setRole(CH);
+    trace(TraceRing::ELECTION, 1);
     broadcastADV(); // broadcast ADV message
     getDisplayString().setTagArg("i", 0, "old/ball2"); // UI feedback
 }
@@ -406,14 +757,14 @@ bool pairCompareEnergy( const std::pair<double, double> &firstEl, const std::pai
 
 void Sensor::createTXSched()
 {
-    clusterN = msgBuf.size();
+    clusterN = members.size();
+    trace(TraceRing::SCHED, clusterN);
 
 #ifdef CH_SLOT_MAXDIST_IN_CLUSTER
     // in order to adjust power of transmission, first keep track of the max_distance of nodes among the ones in the cluster
     sensor_max_dist = -1 * std::numeric_limits<double>::infinity();
-    for(unsigned int i = 0; i < msgBuf.size(); i++){
-        mJoin *JOIN = (mJoin *) msgBuf.at(i);
-        double dist = distance(JOIN->getId());
+    for(unsigned int i = 0; i < members.size(); i++){
+        double dist = distance(members.at(i));
         if(dist > sensor_max_dist){
             sensor_max_dist = dist;
         }
@@ -436,56 +787,67 @@ void Sensor::createTXSched()
     if(par("DistAwareCH") || par("EnergyAwareCH"))
     {
         int center_id = id;
+        if (BSstate->getLedger()) BSstate->settleLedger(); // the strategies compare up to date energies
+        EnergyIndex *energyIndex = BSstate->getEnergyIndex();
 
-        std::vector<std::pair<double, double>> DistBatt;
-        std::vector<std::pair<int, std::pair<double, double>>> List_IDFeat;
-
-        double sumDist = 0;
-        // first set myself
-        for(unsigned int y = 0; y < msgBuf.size(); y++){
-            mJoin *JOIN = (mJoin *) msgBuf.at(y);
-            sumDist += distance(JOIN->getId());
+        if(energyIndex && !par("DistAwareCH").boolValue())
+        {
+            // energy only: the best of the cluster (ourselves first if tied), from the network-wide index
+            std::vector<int> cluster(1, id);
+            cluster.insert(cluster.end(), members.list().begin(), members.list().end());
+            center_id = energyIndex->best(cluster);
         }
-        double max_energy = par("energy");
-        std::pair<double, double> me(sumDist,max_energy - energy);
-        DistBatt.push_back(me);
-        std::pair<int, std::pair<double, double>> meSupport(id,me);
-        List_IDFeat.push_back(meSupport);
-
-        // then check among other nodes in the cluster if there's one better centered
-        // in order to avoid too close CH and more homogeneous transmissions
-        for(unsigned int i = 0; i < msgBuf.size(); i++){
-            sumDist = 0;
-            mJoin *JOIN1 = (mJoin *) msgBuf.at(i);
-            for(unsigned int y = 0; y < msgBuf.size(); y++){
-                mJoin *JOIN2 = (mJoin *) msgBuf.at(y);
-                sumDist += distance2s(JOIN1->getId(),JOIN2->getId());
+        else
+        {
+            std::vector<std::pair<double, double>> DistBatt;
+            std::vector<std::pair<int, std::pair<double, double>>> List_IDFeat;
+
+            double sumDist = 0;
+            // first set myself
+            for(unsigned int y = 0; y < members.size(); y++){
+                sumDist += distance(members.at(y));
             }
+            double max_energy = par("energy");
+            std::pair<double, double> me(sumDist,max_energy - energy);
+            DistBatt.push_back(me);
+            std::pair<int, std::pair<double, double>> meSupport(id,me);
+            List_IDFeat.push_back(meSupport);
+
+            // then check among other nodes in the cluster if there's one better centered
+            // in order to avoid too close CH and more homogeneous transmissions
+            for(unsigned int i = 0; i < members.size(); i++){
+                sumDist = 0;
+                int member1 = members.at(i);
+                for(unsigned int y = 0; y < members.size(); y++){
+                    sumDist += distance2s(member1, members.at(y));
+                }
 
-            Sensor *sensor = check_and_cast<Sensor *>(retrieveNode(JOIN1->getId()));
+                double memberEnergy = (energyIndex && energyIndex->contains(member1)) ? energyIndex->get(member1)
+                        : check_and_cast<Sensor *>(retrieveNode(member1))->getEnergy();
 
 
-            EV << "SumDist for " << JOIN1->getId() << " = " << sumDist << " - energy = " << sensor->getEnergy() << "\n";
-            std::pair<double,double> s(sumDist, max_energy - sensor->getEnergy());
-            DistBatt.push_back(s);
-            std::pair<int, std::pair<double, double>> sSupport(JOIN1->getId(),s);
-            List_IDFeat.push_back(sSupport);
+                EV << "SumDist for " << member1 << " = " << sumDist << " - energy = " << memberEnergy << "\n";
+                std::pair<double,double> s(sumDist, max_energy - memberEnergy);
+                DistBatt.push_back(s);
+                std::pair<int, std::pair<double, double>> sSupport(member1,s);
+                List_IDFeat.push_back(sSupport);
 
-        }
+            }
 
-        if(par("DistAwareCH") && par("EnergyAwareCH"))
-            // sort based on both energy and sum of distances
-            std::sort(DistBatt.begin(),DistBatt.end(),pairCompareBoth);
-        else if(par("DistAwareCH"))
-            std::sort(DistBatt.begin(),DistBatt.end(),pairCompareDist);
-        else if(par("EnergyAwareCH"))
-            std::sort(DistBatt.begin(),DistBatt.end(),pairCompareEnergy);
+            if(par("DistAwareCH") && par("EnergyAwareCH"))
+                // sort based on both energy and sum of distances
+                std::sort(DistBatt.begin(),DistBatt.end(),pairCompareBoth);
+            else if(par("DistAwareCH"))
+                std::sort(DistBatt.begin(),DistBatt.end(),pairCompareDist);
+            else if(par("EnergyAwareCH"))
+                std::sort(DistBatt.begin(),DistBatt.end(),pairCompareEnergy);
 
 
-        // let's find the original id by comparing the first new element
-        for(unsigned l = 0; l < List_IDFeat.size(); l++)
-        {
-            if(List_IDFeat.at(l).second == DistBatt.at(0)) center_id = List_IDFeat.at(l).first;
+            // let's find the original id by comparing the first new element
+            for(unsigned l = 0; l < List_IDFeat.size(); l++)
+            {
+                if(List_IDFeat.at(l).second == DistBatt.at(0)) center_id = List_IDFeat.at(l).first;
+            }
         }
 
         EV << "min SumDist is " << center_id << "\n";
@@ -494,13 +856,13 @@ void Sensor::createTXSched()
         {
             // if we ended up selecting another cluster, reset our CH role
 
-            alreadyCH = false;   // include again for a new election
-            role = SENSOR;
+            setAlreadyCH(false);   // include again for a new election
+            setRole(SENSOR);
             getDisplayString().setTagArg("i", 0, "old/ball"); // UI feedback
 
             //setup new CH information
-            CH_id = center_id;
-            CH_dist = distance(center_id);
+            setCH(center_id, distance(center_id));
+            trace(TraceRing::CENTER, center_id);
 
             // make the new CH aware of it's new role and handle the incoming data
             // send a message (with the num. of sensors in the cluster)
@@ -510,31 +872,20 @@ void Sensor::createTXSched()
             CENTER->setIDLETime(clusterN*slot);
             CENTER->setSCHEDDelay(SCHED_delay);
 
-            cModule *sensor = retrieveNode(CH_id);
             EV << "informing new CH \n";
-            sendDirect(CENTER, 0, 0, sensor->gate("in"));
+            transmit(CENTER, CH_id, 0);
 
             // send to sensors their turn, as if I was in the turn of the new CH
-            for(unsigned int i = 0; i < msgBuf.size(); i++){
-                mJoin *JOIN = (mJoin *) msgBuf.at(i);
-                mSchedule *SCHED = (mSchedule *) new mSchedule("schedule-info", SCHED_M);
-                SCHED->setTurn(i);
-                SCHED->setDuration(slot);
-                SCHED->setRound(par("round"));
-                SCHED->setCHId(center_id); // this specifies where to send the DATA
-
-                if(JOIN->getId() != center_id){ // all except the new clusterhead
-                    cModule *sensor = retrieveNode(JOIN->getId());
-                    EV << "sending schedule to " << JOIN->getId() << "\n";
-                    sendDirect(SCHED, SCHED_delay, 0, sensor->gate("in"));
-                }else{ // instead of clusterhead, send its turn to me
-                    EV << "sending schedule to MYSELF (NOT CH ANYMORE)\n";
-                    scheduleAt(simTime()+SCHED_delay, SCHED);
+            mScheduleTable *SCHED = buildSchedule(slot, center_id); // center_id specifies where to send the DATA
+            for(unsigned int i = 0; i < SCHED->getMembersArraySize(); i++){
+                if(SCHED->getMembers(i) == center_id){ // instead of clusterhead, its turn is mine
+                    EV << "taking turn " << i << " for MYSELF (NOT CH ANYMORE)\n";
+                    SCHED->setMembers(i, id);
                 }
-                cancelAndDelete(JOIN);
             }
+            postSchedule(SCHED, SCHED_delay);
 
-            msgBuf.clear(); // empty buffer
+            members.clear(); // empty buffer
             #ifdef ACCOUNT_CH_SETUP
             //account for energy this transmission based on distance
             EnergyMgmt(TX, sensor_max_dist, SCHED_M_SIZE);
@@ -544,20 +895,10 @@ void Sensor::createTXSched()
         else
         {
             // just send their SCHED information (i.e. their turn to transmit) as usual LEACH
-            for(unsigned int i = 0; i < msgBuf.size(); i++){
-                mJoin *JOIN = (mJoin *) msgBuf.at(i);
-                mSchedule *SCHED = (mSchedule *) new mSchedule("schedule-info", SCHED_M);
-                SCHED->setTurn(i);
-                SCHED->setDuration(slot);
-                SCHED->setRound(par("round"));
-                SCHED->setCHId(id); // this specifies where to send the DATA (ourselves in this case)
-                cModule *sensor = retrieveNode(JOIN->getId());
-                EV << "sending schedule to " << JOIN->getId() << "\n";
-                sendDirect(SCHED, SCHED_delay, 0, sensor->gate("in"));
-                cancelAndDelete(JOIN);
-            }
+            // this specifies where to send the DATA (ourselves in this case)
+            postSchedule(buildSchedule(slot, id), SCHED_delay);
 
-            msgBuf.clear(); // empty buffer
+            members.clear(); // empty buffer
             #ifdef ACCOUNT_CH_SETUP
             //account for energy this transmission based on distance
             EnergyMgmt(TX, sensor_max_dist, SCHED_M_SIZE);
@@ -567,7 +908,7 @@ void Sensor::createTXSched()
             double IDLE_duration = clusterN*slot;
             // setup a timer to keep radio in IDLE mode and receive all data (TDMA)
             // Timeout will take in account the propagation delay for SCHED msg to reach destination and to receive back all data sequentially
-            scheduleAt(simTime() + SCHED_delay + IDLE_duration + EPSILON, rcvdData_e);
+            scheduleTimer(simTime() + SCHED_delay + IDLE_duration + EPSILON, rcvdData_e);
             #ifdef ACCOUNT_CH_SETUP
             // account for energy during IDLE time
             EnergyMgmt(RX, 0, clusterN*DATA_M_SIZE);
@@ -582,20 +923,9 @@ void Sensor::createTXSched()
     {
 
         // now send their SCHED information (i.e. their turn to transmit)
-        for(unsigned int i = 0; i < msgBuf.size(); i++){
-            mJoin *JOIN = (mJoin *) msgBuf.at(i);
-            mSchedule *SCHED = (mSchedule *) new mSchedule("schedule-info", SCHED_M);
-            SCHED->setTurn(i);
-            SCHED->setDuration(slot);
-            SCHED->setRound(par("round"));
-            SCHED->setCHId(id);
-            cModule *sensor = retrieveNode(JOIN->getId());
-            EV << "sending schedule to " << JOIN->getId() << "\n";
-            sendDirect(SCHED, SCHED_delay, 0, sensor->gate("in"));
-            cancelAndDelete(JOIN);
-        }
+        postSchedule(buildSchedule(slot, id), SCHED_delay);
 
-        msgBuf.clear(); // empty buffer
+        members.clear(); // empty buffer
         #ifdef ACCOUNT_CH_SETUP
         //account for energy this transmission based on distance
         EnergyMgmt(TX, sensor_max_dist, SCHED_M_SIZE);
@@ -605,7 +935,7 @@ void Sensor::createTXSched()
         double IDLE_duration = clusterN*slot;
         // setup a timer to keep radio in IDLE mode and receive all data (TDMA)
         // Timeout will take in account the propagation delay for SCHED msg to reach destination and to receive back all data sequentially
-        scheduleAt(simTime() + SCHED_delay + IDLE_duration + EPSILON, rcvdData_e);
+        scheduleTimer(simTime() + SCHED_delay + IDLE_duration + EPSILON, rcvdData_e);
         #ifdef ACCOUNT_CH_SETUP
         // account for energy during IDLE time
         EnergyMgmt(RX, 0, clusterN*DATA_M_SIZE);
@@ -627,48 +957,72 @@ void Sensor::compressAndSendToBS()
     //unsigned int data_aggr_size = ceil((clusterN*DATA_M_SIZE)/COMP_FACTOR);
     unsigned int data_aggr_size = DATA_M_SIZE; // we just assume all the same packet size transmitted to BS after compression
 
-#ifdef USE_BS_DIST
-    EnergyMgmt(TX, BS_DIST(x,y), data_aggr_size);
-#else
-    EnergyMgmt(TX, MAX_DIST(range), data_aggr_size);
-#endif
+    if(multiHop){
+        // send the aggregate along the CH tree instead of paying the long uplink
+        mRelay *RELAY = new mRelay("aggregate", RELAY_M);
+        RELAY->setId(id);
+        RELAY->setRound(par("round"));
+        RELAY->setHops(0);
+        forwardAggregate(RELAY);
+        return;
+    }
+
+    EnergyMgmtTX(uplinkLink, data_aggr_size);
+    trace(TraceRing::DATA, BS_ID);
 
 #ifndef ONE_TX_PER_ROUND
     // set-up the next transmission
-    // in this case, we avoid to clear the buffer. We're gonna exploit polymorphism to
-    // use DATA packets as JOIN packets in the new schedule creation (they both have id field).
+    // in this case, we avoid to clear the inbox: the ids of the DATA senders
+    // are used as JOINs in the new schedule creation.
     // This is useful for keeping track of nodes that are still sending DATA (in case someone died) and adjust
     // the TDMA schedule accordingly
-#ifdef USE_BS_DIST
-    double delay = propagationDelay(data_aggr_size, BS_DIST(x,y));
-#else
-    double delay = propagationDelay(data_aggr_size, MAX_DIST(range));
-#endif
-    scheduleAt(simTime()+delay,rcvdJoin_e); // schedule next transmission after Aggregated data has been (virtually) sent
+    double delay = propagationDelay(data_aggr_size, uplinkDist);
+    scheduleTimer(simTime()+delay, rcvdJoin_e); // schedule next transmission after Aggregated data has been (virtually) sent
 #endif
 }
 
+void Sensor::forwardAggregate(mRelay *RELAY)
+{
+    // next hop is either a CH closer to the BS or the BS itself
+    CHRouter *router = BSstate->getRouter();
+    int next = router->nextHop(id);
+    double d = (next == BS_ID) ? sinkDist : router->hopDistance(id);
+
+    RELAY->setHops(RELAY->getHops() + 1);
+    EV << "forwarding aggregate of " << RELAY->getId() << " to " << next << " (" << d << " m)\n";
+    transmit(RELAY, next, propagationDelay(DATA_M_SIZE, d));
+    // ACCOUNT FOR THE HOP TRANSMISSION
+    EnergyMgmt(TX, d, DATA_M_SIZE);
+}
+
 void Sensor::handleData(cMessage *msg)
 {
     unsigned int r = par("round");
     mData *DATA = (mData *) msg;
     if ((role == CH) && (r == DATA->getRound())){
-        msgBuf.push_back(msg); // insert DATA into the message buffer
-        EV << "received data from " << msg->getSenderModuleId() - 2 << "\n";
+        members.add(DATA->getId(), DATA->getRound()); // DATA senders serve as JOINs for the next schedule
+        EV << "received data from " << DATA->getId() << "\n";
     }
+    cancelAndDelete(msg);
 }
 
 /********* ENERGY functions **********/
 // energy consumption to transmit k bit ad distance d
 double Sensor::EnergyTX(unsigned int k, double d)
 {
-    return ((Eelec * k) + Eamp * k * pow(d,2));
+    return radio.TX(k, d);
+}
+
+// energy consumption to transmit k bit over a precomputed link (no distance math on the hot path)
+double Sensor::EnergyTX(unsigned int k, const RadioLink &link)
+{
+    return radio.TX(k, link);
 }
 
 // energy consumption to receive k bit
 double Sensor::EnergyRX(unsigned int k)
 {
-    return Eelec * k;
+    return radio.RX(k);
 }
 
 // energy consumption to aggregate n messages of k bits (kN = k* n)
@@ -699,12 +1053,34 @@ void Sensor::EnergyMgmt(compState state, double d, unsigned int k)
             break;
     }
 
+    drainBattery(cost);
+}
+
+void Sensor::EnergyMgmtTX(const RadioLink &link, unsigned int k)
+{
+    double cost = EnergyTX(k, link);
+    EV << "TX cost is " << cost << " and energy is " << energy << " " << (cost < energy) << "\n";
+
+    drainBattery(cost);
+}
+
+void Sensor::drainBattery(double cost)
+{
+    EnergyLedger *ledger = BSstate ? BSstate->getLedger() : nullptr;
+    if (ledger) {
+        if (role != DEAD && ledger->defer(id, cost, energy))
+            return; // it can't kill us: paid when the ledger is settled
+        settleEnergy(); // pay our debts first, then this cost as usual
+    }
+
     emit(energySignal, energy);
 
     if (cost < energy)
     {
         // if we have enough energy, subtract the cost of operation from the actual energy
         energy -= cost;
+        EnergyIndex *energyIndex = BSstate ? BSstate->getEnergyIndex() : nullptr;
+        if (energyIndex) energyIndex->update(id, energy);
         char buf[256];
         sprintf(buf, "energy %.2f\n", energy);
         getDisplayString().setTagArg("t", 0, buf);
@@ -712,25 +1088,84 @@ void Sensor::EnergyMgmt(compState state, double d, unsigned int k)
     else
     {
         //this operation will make the node die, so we can simply declare it as dead
-        role = DEAD;
+        setRole(DEAD);
         EV << "Node " << id << " is DEAD.\n";
+        trace(TraceRing::DEATH, 0);
         getDisplayString().setTagArg("i", 0, "old/ball"); // UI feedback
         getDisplayString().setTagArg("i2", 0, "old/x_cross");
-        cancelEvent(startRound_e);
+        cancelTimer(startRound_e);
+        if (partitioned)
+        {
+            // the BS may be in another partition: it keeps the count of dead nodes
+            mDead *DEAD = new mDead("node-dead", DEAD_M);
+            DEAD->setId(id);
+            DEAD->setRound(par("round"));
+            transmit(DEAD, BS_ID, propagationDelay(JOIN_M_SIZE, 0));
+            return;
+        }
+        bool first = BSstate->nodeDied(id);
         unsigned int Ndead = getParentModule()->par("Ndead");
         getParentModule()->par("Ndead") = Ndead+1;
-        if (Ndead+1 == N) endSimulation(); // stop simulation if all nodes are dead
+        if (Ndead+1 == BSstate->getDeployed()) BSstate->networkDead(); // stop simulation if all nodes are dead
         int r = getParentModule()->par("round");
-        if (Ndead+1 == 1) recordScalar("firstNodeDead", r);
+        if (first) recordScalar("firstNodeDead", r);
     }
 }
 
 
 /********* Utilities ************/
+void Sensor::setRole(nodeRole role)
+{
+    if(multiHop){
+        // keep the CH set of the routing tree up to date
+        if(role == CH && this->role != CH)
+            BSstate->getRouter()->addCH(id, x, y);
+        else if(role != CH && this->role == CH)
+            BSstate->getRouter()->removeCH(id);
+    }
+    this->role = role;
+}
+
+void Sensor::setAlreadyCH(bool alreadyCH)
+{
+    if(electionEngine){
+        // keep the eligible set of the election engine in sync
+        if(alreadyCH)
+            BSstate->getElection()->markCH(id);
+        else
+            BSstate->getElection()->unmarkCH(id);
+    }
+    this->alreadyCH = alreadyCH;
+}
+
+void Sensor::setCH(int CH_id, double CH_dist)
+{
+    this->CH_id = CH_id;
+    this->CH_dist = CH_dist;
+    CHLink = radio.link(CH_dist);
+    stampCH();
+}
+
+void Sensor::transmit(cMessage *msg, int dest, double delay)
+{
+    if(partitioned){
+        // the proxy of our partition takes care of the delivery
+        msg->addPar("dest") = (long) dest;
+        msg->addPar("delay") = delay;
+        send(msg, "out");
+    }
+    else if(dest == BS_ID)
+        sendDirect(msg, delay, 0, sink->gate("in"));
+    else if(BSstate->isAlive(dest))
+        sendDirect(msg, delay, 0, BSstate->getNode(dest)->gate("in"));
+    else
+        delete msg; // dead nodes would just drop it
+}
+
 cModule* Sensor::retrieveNode(unsigned int n)
 {
    char modName[32];
-   sprintf(modName,"node[%d]", n);
+   sprintf(modName,"^.node[%d]", n); // relative: the network may be a lane of Lanes_net
    return (cModule *) getModuleByPath(modName);
 }
 
@@ -765,8 +1200,32 @@ double Sensor::distance2s(unsigned int id1, unsigned int id2)
     return sqrt( pow(dx,2) + pow(dy,2));
 }
 
+void Sensor::settleEnergy()
+{
+    // pay the costs deferred in the ledger, in the order they happened
+    Enter_Method_Silent();
+    EnergyLedger *ledger = BSstate ? BSstate->getLedger() : nullptr;
+    if (!ledger || !ledger->owes(id)) return;
+    ledger->take(id, owed);
+    for(unsigned int i = 0; i < owed.size(); i++){
+        if (owed[i] < energy)
+            energy -= owed[i];
+        else {
+            drainBattery(owed[i]); // never happens with the ledger margin, but dies as usual
+            return;
+        }
+    }
+    emit(energySignal, energy);
+    EnergyIndex *energyIndex = BSstate->getEnergyIndex();
+    if (energyIndex) energyIndex->update(id, energy);
+    char buf[256];
+    sprintf(buf, "energy %.2f\n", energy);
+    getDisplayString().setTagArg("t", 0, buf);
+}
+
 double Sensor::getEnergy()
 {
+    settleEnergy();
     return energy;
 }
 
@@ -19,6 +19,13 @@
 #include <algorithm>
 #include <omnetpp.h>
 #include "common.h"
+#include "radio.h"
+#include "inbox.h"
+#include "checkpoint.h"
+#include "philox.h"
+#include "ledger.h"
+
+class BS;
 
 using namespace omnetpp;
 
@@ -32,8 +39,17 @@ class Sensor : public cSimpleModule
     bool alreadyCH = false; // indicates whether the node has elected himself a CH or not in the current round
     double P;               // proportion of CH in the current network
 
+    bool centralized;       // CH and cluster are assigned by the BS (LEACH-C)
+    bool multiHop;          // aggregates are forwarded to the BS over the CH tree
+    bool electionEngine;    // CH election is drawn by the BS for the whole network
+    bool roundTick;         // rounds are started by the BS, not by startRound_e
+    bool partitioned;       // messages go through the proxy of our partition (Parallel_net)
+    bool phaseBuckets;      // timers are kept in the phase buckets of the BS, not in the FES
+    bool counterRNG;        // election and placement draws come from crng, not from the module RNG
+    CounterRNG crng;
+
     int CH_id = -1;         // Cluster-Head id
-    double CH_dist;         // Cluster-Head distance
+    double CH_dist = std::numeric_limits<double>::infinity();  // Cluster-Head distance
     double TXslot;
     double TXturn;
 
@@ -43,15 +59,28 @@ class Sensor : public cSimpleModule
     double roundTime;
 
     cModule *BS;
+    ::BS *BSstate;          // BS module, owner of the network-wide structures
+    std::vector<cModule *> sinks;   // the BS, then the extra sinks of the network
+    cModule *sink;          // nearest sink (the BS or an extra sink): our uplinks go there
+    double sinkDist;        // distance to it
+    double uplinkDist;      // distance paid by uplinks: sinkDist, or MAX_DIST(range) with a single far away BS
 
     double C = LIGHTSPEED;
     double bitrate;   // bitrate of sensors
     double range;        // it will be the max communication range of sensors
 
     double Eelec, Eamp, Ecomp, gamma;  // energy parameters
+    double Emp, d0;             // multipath amplifier and crossover distance
     double energy;              // initial battery energy
 
-    std::vector<cMessage *> msgBuf;
+    RadioModel radio;
+    RadioLink uplinkLink;   // precomputed amplifier cost towards the sink
+    RadioLink maxLink;      // precomputed amplifier cost at MAX_DIST(range)
+    RadioLink CHLink;       // amplifier cost towards the current CH (updated with CH_dist)
+    uint32_t CHStamp[2];    // moves of us and of our CH when CH_dist was computed (mobility)
+
+    MemberInbox members;    // ids of the nodes that sent JOIN (or DATA) to this CH in the current round
+    std::vector<double> owed;   // costs taken from the energy ledger, being paid
 
     cMessage *startRound_e;
     cMessage *startTX_e;    // event used to start DATA TX from sensor nodes
@@ -83,21 +112,54 @@ class Sensor : public cSimpleModule
     virtual void advertisementPhase();
     virtual void selfElection();
     virtual void broadcastADV();
+    virtual void handleADV(mAdvertisement *ADV);
     virtual void chooseCH();
     virtual void createTXSched();
-    virtual void setupDataTX(mSchedule *SCHED);
+    virtual void setupDataTX(mScheduleTable *SCHED, unsigned int turn);
+    virtual mScheduleTable *buildSchedule(double slot, int CHId);
+    virtual void dispatchSchedule(mScheduleTable *SCHED);
+    virtual void postSchedule(mScheduleTable *SCHED, double delay);
+    virtual void readSchedule(mScheduleTable *SCHED);
+    virtual void transmit(cMessage *msg, int dest, double delay);
+    virtual void handleAssignment(mAssign *ASSIGN);
     virtual void sendData();
     virtual void initOrphan();
     virtual void compressAndSendToBS();
+    virtual void forwardAggregate(mRelay *RELAY);
+    virtual void setRole(nodeRole role);
+    virtual void setAlreadyCH(bool alreadyCH);
     virtual void handleData(cMessage *msg);
     virtual double EnergyTX(unsigned int k, double d);
+    virtual double EnergyTX(unsigned int k, const RadioLink &link);
     virtual double EnergyRX(unsigned int k);
     virtual double EnergyCompress(unsigned int kN);
     virtual void EnergyMgmt(compState state, double d, unsigned int k);
+    virtual void EnergyMgmtTX(const RadioLink &link, unsigned int k);
+    virtual void drainBattery(double cost);
+    virtual void scheduleTimer(simtime_t t, cMessage *timer);
+    virtual void cancelTimer(cMessage *timer);
+    virtual void setCH(int CH_id, double CH_dist);
+    virtual void trace(int kind, int arg);
+    virtual void locateSink();
+    virtual void stampCH();
+    virtual void refreshCH();
 
 
   public:
     virtual double getEnergy();
+    virtual void settleEnergy();
+    virtual int getX() { return x; }
+    virtual int getY() { return y; }
+    virtual bool isAlive() { return role != DEAD; }
+    virtual nodeRole getRole() { return role; }
+    virtual int getCH() { return CH_id; }
+    virtual bool getAlreadyCH() { return alreadyCH; }
+    virtual void restore(const NodeCheckpoint &state, int round);
+    virtual void revive(double battery, int round, simtime_t start);
+    virtual void startRound();
+    virtual void fireTimer(short kind);
+    virtual void receiveSchedule(mScheduleTable *SCHED, unsigned int turn);
+    virtual void moveTo(int x, int y);
 };
 
 
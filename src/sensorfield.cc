@@ -0,0 +1,554 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <algorithm>
+#include <unordered_set>
+#include "sensorfield.h"
+#include "topology.h"
+#include "election.h"
+#include "BS.h"
+
+#ifndef ONE_TX_PER_ROUND
+#error "SensorField only implements the one-transmission-per-round LEACH (ONE_TX_PER_ROUND)"
+#endif
+#ifdef USE_BS_DIST
+#error "SensorField does not implement USE_BS_DIST"
+#endif
+
+Define_Module(SensorField);
+
+void SensorField::initialize()
+{
+    cModule *net = getParentModule();
+    P = net->par("P");
+    N = net->par("Nnodes");
+    electionEngine = net->par("electionEngine");
+    roundTick = net->par("roundTick");
+    counterRNG = net->par("counterRNG");
+    crng.setSeed(net->par("rngSeed").intValue());
+    if (net->par("centralized").boolValue() || net->par("multiHop").boolValue() || net->par("partitioned").boolValue()
+            || par("DistAwareCH").boolValue() || par("EnergyAwareCH").boolValue())
+        throw cRuntimeError("SensorField only runs distributed LEACH: centralized, multiHop, partitioned, DistAwareCH and EnergyAwareCH are not supported");
+
+    double edge = net->par("edge");
+    range = sqrt(2*pow(edge,2));
+    bitrate = par("bitrate");
+    Ecomp = par("Ecomp");
+    radio.setup(par("Eelec"), par("Eamp"), par("Emp"), par("gamma"), par("d0"));
+    maxLink = radio.link(MAX_DIST(range));
+
+    BS = net->getSubmodule("baseStation");
+    BSstate = check_and_cast< ::BS *>(BS);
+    ::BS::collectSinks(net, sinks);
+
+    x.assign(N, 0);
+    y.assign(N, 0);
+    round.assign(N, -1);
+    role.assign(N, SENSOR);
+    alreadyCH.assign(N, false);
+    CH_id.assign(N, -1);
+    CH_dist.assign(N, std::numeric_limits<double>::infinity());
+    CHStamp[0].assign(N, 0);
+    CHStamp[1].assign(N, 0);
+    clusterN.assign(N, 0);
+    for (int k = 0; k < F_TIMERS; k++)
+        timer[k].assign(N, 0);
+    nextSeq = 1;
+
+    // initial energy: one evaluation per node, as the parameter of each Sensor module
+    energy.resize(N);
+    for (unsigned int n = 0; n < N; n++)
+        energy[n] = par("energy");
+
+    std::string topologyFile = net->par("topologyFile").stdstringValue();
+    if (!topologyFile.empty()) {
+        // same deployment as the other runs on this file, no draws
+        const Topology *topology = Topology::get(topologyFile);
+        if (!topology)
+            throw cRuntimeError("can't read topology file %s", topologyFile.c_str());
+        if (topology->size() != N || topology->getEdge() != (int) edge)
+            throw cRuntimeError("topology file %s has %d nodes on a %d m edge, the network %d nodes on a %g m edge",
+                    topologyFile.c_str(), topology->size(), topology->getEdge(), N, edge);
+        for (unsigned int n = 0; n < N; n++) {
+            x[n] = topology->x(n);
+            y[n] = topology->y(n);
+            if (topology->hasEnergy()) energy[n] = topology->getEnergy(n);
+        }
+    }
+    else {
+        // positions, drawn like Sensor::initialize(): a position is taken if an
+        // earlier node has it, or if it is (0,0) (the default of the nodes not placed yet)
+        int minX = net->par("minX"), minY = net->par("minY");
+        std::unordered_set<long long> taken;
+        taken.insert(0);
+        for (unsigned int n = 0; n < N; n++) {
+            long long key;
+            unsigned int attempt = 0;
+            do {
+                if (counterRNG) {
+                    x[n] = crng.intuniform(minX, net->par("edge"), n, attempt, CounterRNG::PLACEMENT, 0);
+                    y[n] = crng.intuniform(minY, net->par("edge"), n, attempt, CounterRNG::PLACEMENT, 1);
+                    attempt++;
+                }
+                else {
+                    x[n] = intuniform(minX, net->par("edge"));
+                    y[n] = intuniform(minY, net->par("edge"));
+                }
+                key = ((long long) (unsigned int) x[n] << 32) | (unsigned int) y[n];
+            } while (taken.count(key));
+            taken.insert(key);
+        }
+    }
+
+    // nearest sink of every node, once: nodes don't move
+    sink.resize(N);
+    uplinkDist.resize(N);
+    uplinkLink.resize(N);
+    for (unsigned int n = 0; n < N; n++)
+        locateSink(n);
+
+    // the last Nspares nodes are spares, deployed by the BS later on (see revive)
+    unsigned int Nspares = net->par("Nspares");
+    unsigned int deployed = N - std::min(N, Nspares);
+    for (unsigned int n = deployed; n < N; n++)
+        role[n] = DEAD;
+
+    if (!roundTick)
+        for (unsigned int n = 0; n < deployed; n++)
+            scheduleTimer(n, F_START_ROUND, 0);
+}
+
+void SensorField::finish()
+{
+    for (std::map<simtime_t, cMessage *>::iterator it = wakes.begin(); it != wakes.end(); ++it)
+        cancelAndDelete(it->second);
+    wakes.clear();
+}
+
+/********* internal event queue **********/
+void SensorField::push(simtime_t t, int node, int kind, int arg, int arg2)
+{
+    Event e;
+    e.t = t;
+    e.seq = nextSeq++;
+    e.node = node;
+    e.kind = kind;
+    e.arg = arg;
+    e.arg2 = arg2;
+    events.push(e);
+    if (wakes.find(t) == wakes.end()) {
+        cMessage *wake = new cMessage("field-wake");
+        wakes[t] = wake;
+        scheduleAt(t, wake);
+    }
+}
+
+void SensorField::scheduleTimer(int n, int kind, simtime_t t)
+{
+    push(t, n, kind);
+    timer[kind][n] = nextSeq - 1;
+}
+
+void SensorField::handleMessage(cMessage *msg)
+{
+    // process the events of this timestamp that were scheduled before the wake-up:
+    // the ones scheduled meanwhile at the same time got their own wake-up, after this one
+    simtime_t now = simTime();
+    wakes.erase(now);
+    delete msg;
+    uint64_t limit = nextSeq;
+    while (!events.empty() && events.top().t == now && events.top().seq < limit) {
+        Event e = events.top();
+        events.pop();
+        processEvent(e);
+    }
+}
+
+void SensorField::processEvent(const Event &e)
+{
+    int n = e.node;
+    if (e.kind < F_TIMERS) {
+        if (timer[e.kind][n] != e.seq) return; // cancelled
+        timer[e.kind][n] = 0;
+        if (role[n] == DEAD) return; // dead nodes ignore their timers
+    }
+
+    switch (e.kind)
+    {
+        case F_START_ROUND:
+            selfElection(n);
+            scheduleTimer(n, F_START_ROUND, simTime()+roundTime);
+            break;
+        case F_RCVD_ADV:
+            chooseCH(n);
+            break;
+        case F_RCVD_JOIN:
+            if (inbox.count(n) && inbox[n].size() > 0)
+                createTXSched(n);
+            else {
+                reset(n);
+                initOrphan(n);
+            }
+            break;
+        case F_RCVD_DATA:
+            compressAndSendToBS(n);
+            break;
+        case F_START_TX:
+            sendData(n);
+            break;
+        case F_ADV:
+            handleADV(e.arg);
+            break;
+        case F_JOIN:
+            if (role[n] != DEAD)
+                handleJoin(n, e.arg, e.arg2);
+            break;
+        case F_SCHED:
+            dispatchSchedule(n, e.arg);
+            break;
+    }
+}
+
+/********* LEACH **********/
+double SensorField::propagationDelay(unsigned int msg_size, double dist)
+{
+    double Dp = msg_size / bitrate; // packet duration
+    return dist/C + Dp;  // propagation delay
+}
+
+void SensorField::startRound(int n)
+{
+    // called by the BS at every round (roundTick mode)
+    Enter_Method_Silent();
+    if (role[n] != DEAD)
+        selfElection(n);
+}
+
+void SensorField::reset(int n)
+{
+    role[n] = SENSOR;
+    inbox.erase(n);
+    CH_id[n] = -1;
+    CH_dist[n] = std::numeric_limits<double>::infinity();
+    clusterN[n] = 0;
+    cancelTimer(n, F_RCVD_ADV);
+    cancelTimer(n, F_RCVD_JOIN);
+    cancelTimer(n, F_RCVD_DATA);
+    cancelTimer(n, F_START_TX);
+}
+
+void SensorField::selfElection(int n)
+{
+    unsigned int r = round[n] + 1;
+    round[n] = r;
+    if (r == 0) roundTime = getParentModule()->par("roundTime");
+    if (r > 0) reset(n);
+
+    if ((r % leachEpoch(P)) == 0) alreadyCH[n] = false;
+
+    bool elected;
+    if (electionEngine)
+        elected = BSstate->isElected(r, n);
+    else
+    {
+        double th = alreadyCH[n] ? 0 : leachThreshold(P, r);
+        double chance = counterRNG ? crng.uniform01(n, r, CounterRNG::ELECTION) : uniform(0,1);
+        elected = (chance < th);
+    }
+
+    if (elected)
+        advertisementPhase(n);
+    else
+    {
+        scheduleTimer(n, F_RCVD_ADV, simTime() + propagationDelay(ADV_M_SIZE, MAX_DIST(range))+EPSILON);
+#ifdef ACCOUNT_CH_SETUP
+        drainBattery(n, radio.RX(ADV_M_SIZE));
+#endif
+    }
+}
+
+void SensorField::advertisementPhase(int n)
+{
+    setAlreadyCH(n, true);
+    role[n] = CH;
+    BSstate->traceEvent(TraceRing::ELECTION, n, 1);
+
+    // one event for all the copies: they all arrive at the same time
+    double ADV_delay = propagationDelay(ADV_M_SIZE, MAX_DIST(range));
+    push(simTime()+ADV_delay, n, F_ADV, n);
+#ifdef ACCOUNT_CH_SETUP
+    drainBattery(n, radio.TX(ADV_M_SIZE, maxLink));
+#endif
+    double JOIN_delay = propagationDelay(JOIN_M_SIZE, MAX_DIST(range));
+    scheduleTimer(n, F_RCVD_JOIN, simTime() + ADV_delay+JOIN_delay+EPSILON);
+#ifdef ACCOUNT_CH_SETUP
+    drainBattery(n, radio.RX(JOIN_M_SIZE));
+#endif
+}
+
+void SensorField::handleADV(int CH)
+{
+    // every alive sensor keeps the nearest CH so far (strict: ties go to the first ADV)
+    const std::vector<int> &alive = BSstate->getAlive()->list();
+    for (unsigned int i = 0; i < alive.size(); i++) {
+        int n = alive[i];
+        if (n == CH || role[n] != SENSOR) continue;
+        double dx = x[n] - ((double) x[CH]);
+        double dy = y[n] - ((double) y[CH]);
+        double dist = sqrt( pow(dx,2) + pow(dy,2));
+        if (dist < CH_dist[n])
+            setCH(n, CH, dist);
+    }
+}
+
+void SensorField::chooseCH(int n)
+{
+    refreshCH(n);
+    if (CH_id[n] > -1) {
+        double delay = propagationDelay(JOIN_M_SIZE, CH_dist[n]);
+        if (BSstate->isAlive(CH_id[n]))
+            push(simTime()+delay, CH_id[n], F_JOIN, n, round[n]);
+        BSstate->traceEvent(TraceRing::JOIN, n, CH_id[n]);
+#ifdef ACCOUNT_CH_SETUP
+        drainBattery(n, radio.TX(JOIN_M_SIZE, radio.link(CH_dist[n])));
+#endif
+    }
+    else
+        initOrphan(n);
+}
+
+void SensorField::initOrphan(int n)
+{
+    // set BS (the nearest sink) as CH and notify it
+    setCH(n, BS_ID, uplinkDist[n]);
+    mJoin *JOIN = new mJoin("join-cluster", JOIN_M);
+    double delay = propagationDelay(JOIN_M_SIZE, CH_dist[n]);
+    JOIN->setId(n);
+    JOIN->setRound(round[n]);
+    sendDirect(JOIN, delay, 0, sinks[sink[n]]->gate("in"));
+    BSstate->traceEvent(TraceRing::JOIN, n, BS_ID);
+#ifdef ACCOUNT_CH_SETUP
+    drainBattery(n, radio.TX(JOIN_M_SIZE, radio.link(CH_dist[n])));
+#endif
+}
+
+void SensorField::handleJoin(int n, int member, int r)
+{
+    std::unordered_map<int, MemberInbox>::iterator it = inbox.find(n);
+    if (it == inbox.end()) {
+        it = inbox.emplace(n, MemberInbox()).first;
+        it->second.open(round[n]);
+    }
+    it->second.add(member, r);
+}
+
+void SensorField::createTXSched(int n)
+{
+    MemberInbox &members = inbox[n];
+    clusterN[n] = members.size();
+    BSstate->traceEvent(TraceRing::SCHED, n, clusterN[n]);
+
+#ifdef CH_SLOT_MAXDIST_IN_CLUSTER
+    double sensor_max_dist = -1 * std::numeric_limits<double>::infinity();
+    for (unsigned int i = 0; i < members.size(); i++) {
+        int m = members.at(i);
+        double dx = x[n] - ((double) x[m]);
+        double dy = y[n] - ((double) y[m]);
+        double dist = sqrt( pow(dx,2) + pow(dy,2));
+        if (dist > sensor_max_dist) sensor_max_dist = dist;
+    }
+    double slot = propagationDelay(DATA_M_SIZE, sensor_max_dist);
+    double SCHED_delay = propagationDelay(SCHED_M_SIZE, sensor_max_dist);
+#else
+    double sensor_max_dist = MAX_DIST(range);
+    double slot = propagationDelay(DATA_M_SIZE, MAX_DIST(range));
+    double SCHED_delay = propagationDelay(SCHED_M_SIZE, MAX_DIST(range));
+#endif
+
+    // the TDMA table, handed to the members when it's on air
+    int t;
+    if (freeTables.empty()) {
+        t = tables.size();
+        tables.push_back(Table());
+    } else {
+        t = freeTables.back();
+        freeTables.pop_back();
+    }
+    tables[t].duration = slot;
+    tables[t].round = round[n];
+    tables[t].members = members.list();
+    push(simTime()+SCHED_delay, n, F_SCHED, t);
+
+    members.clear();
+#ifdef ACCOUNT_CH_SETUP
+    drainBattery(n, radio.TX(SCHED_M_SIZE, radio.link(sensor_max_dist)));
+#endif
+
+    double IDLE_duration = clusterN[n]*slot;
+    scheduleTimer(n, F_RCVD_DATA, simTime() + SCHED_delay + IDLE_duration + EPSILON);
+#ifdef ACCOUNT_CH_SETUP
+    drainBattery(n, radio.RX(clusterN[n]*DATA_M_SIZE));
+#endif
+}
+
+void SensorField::dispatchSchedule(int n, int t)
+{
+    Table &table = tables[t];
+    for (unsigned int i = 0; i < table.members.size(); i++) {
+        int member = table.members[i];
+        if (member != n && BSstate->isAlive(member) && role[member] != DEAD)
+            setupDataTX(member, table.duration, table.round, i);
+    }
+    table.members.clear();
+    freeTables.push_back(t);
+}
+
+void SensorField::receiveSchedule(int n, mScheduleTable *SCHED, unsigned int turn)
+{
+    // called by the BS when its TDMA table reaches node n
+    Enter_Method_Silent();
+    if (role[n] != DEAD)
+        setupDataTX(n, SCHED->getDuration(), SCHED->getRound(), turn);
+}
+
+void SensorField::setupDataTX(int n, double duration, int r, unsigned int turn)
+{
+    if (round[n] == r)
+        scheduleTimer(n, F_START_TX, simTime()+(duration*turn));
+    else
+        BSstate->traceAnomaly(TraceRing::STALE_SCHED, n);
+}
+
+void SensorField::sendData(int n)
+{
+    refreshCH(n);
+    if (CH_id[n] > -1) {
+        double delay = propagationDelay(DATA_M_SIZE, CH_dist[n]);
+        if (CH_id[n] == BS_ID) {
+            mData *DATA = new mData("data", DATA_M);
+            DATA->setId(n);
+            DATA->setRound(round[n]);
+            sendDirect(DATA, delay, 0, sinks[sink[n]]->gate("in"));
+        }
+        BSstate->traceEvent(TraceRing::DATA, n, CH_id[n]);
+        // (a DATA to a CH only matters for its energy: with one TX per round it is not used for the next schedule)
+        drainBattery(n, radio.TX(DATA_M_SIZE, radio.link(CH_dist[n])));
+    }
+}
+
+void SensorField::compressAndSendToBS(int n)
+{
+    drainBattery(n, Ecomp * (clusterN[n]*DATA_M_SIZE));
+    drainBattery(n, radio.TX(DATA_M_SIZE, uplinkLink[n]));
+    BSstate->traceEvent(TraceRing::DATA, n, BS_ID);
+}
+
+void SensorField::drainBattery(int n, double cost)
+{
+    if (role[n] == DEAD) return;
+    if (cost < energy[n])
+        energy[n] -= cost;
+    else
+    {
+        role[n] = DEAD;
+        EV << "Node " << n << " is DEAD.\n";
+        BSstate->traceEvent(TraceRing::DEATH, n, 0);
+        cancelTimer(n, F_START_ROUND);
+        bool first = BSstate->nodeDied(n);
+        cModule *net = getParentModule();
+        unsigned int Ndead = net->par("Ndead");
+        net->par("Ndead") = Ndead+1;
+        if (Ndead+1 == BSstate->getDeployed()) BSstate->networkDead(); // stop simulation if all nodes are dead
+        int r = net->par("round");
+        if (first) recordScalar("firstNodeDead", r);
+    }
+}
+
+void SensorField::setAlreadyCH(int n, bool alreadyCH)
+{
+    if (electionEngine) {
+        if (alreadyCH)
+            BSstate->getElection()->markCH(n);
+        else
+            BSstate->getElection()->unmarkCH(n);
+    }
+    this->alreadyCH[n] = alreadyCH;
+}
+
+void SensorField::setCH(int n, int CH_id, double CH_dist)
+{
+    this->CH_id[n] = CH_id;
+    this->CH_dist[n] = CH_dist;
+    Mobility *mobility = BSstate->getMobility();
+    if (mobility && CH_id >= 0 && CH_id != BS_ID) {
+        CHStamp[0][n] = mobility->getStamp(n);
+        CHStamp[1][n] = mobility->getStamp(CH_id);
+    }
+}
+
+void SensorField::locateSink(int n)
+{
+    double dist;
+    sink[n] = ::BS::nearestSink(sinks, x[n], y[n], dist);
+#ifdef USE_BS_DIST
+    uplinkDist[n] = dist;
+#else
+    uplinkDist[n] = (sinks.size() > 1) ? dist : MAX_DIST(range);    // see Sensor::locateSink
+#endif
+    uplinkLink[n] = radio.link(uplinkDist[n]);
+}
+
+void SensorField::refreshCH(int n)
+{
+    // with mobility, CH_dist is stale if the node or its CH moved since it was computed
+    Mobility *mobility = BSstate->getMobility();
+    if (!mobility || CH_id[n] < 0) return;
+    int CH = CH_id[n];
+    if (CH == BS_ID) {
+        if (CH_dist[n] != uplinkDist[n]) setCH(n, BS_ID, uplinkDist[n]);
+    }
+    else if (mobility->getStamp(n) != CHStamp[0][n] || mobility->getStamp(CH) != CHStamp[1][n]) {
+        double dx = x[n] - ((double) x[CH]);
+        double dy = y[n] - ((double) y[CH]);
+        setCH(n, CH, sqrt( pow(dx,2) + pow(dy,2)));
+    }
+}
+
+void SensorField::revive(int n, double battery, int round, simtime_t start)
+{
+    // called by the BS (maintenance), same as Sensor::revive
+    Enter_Method_Silent();
+    energy[n] = (battery < 0) ? par("energy").doubleValue() : battery;
+    if (role[n] != DEAD) return;
+
+    this->round[n] = round;
+    roundTime = getParentModule()->par("roundTime");
+    reset(n);
+    for (int k = 0; k < F_TIMERS; k++)
+        cancelTimer(n, k);
+    setAlreadyCH(n, true); // waits for the next epoch
+    if (!roundTick)
+        scheduleTimer(n, F_START_ROUND, start);
+}
+
+void SensorField::moveTo(int n, int x, int y)
+{
+    // called by the BS (mobility): CH_dist follows lazily (see refreshCH)
+    Enter_Method_Silent();
+    this->x[n] = x;
+    this->y[n] = y;
+    locateSink(n);
+}
@@ -0,0 +1,162 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_SENSORFIELD_H_
+#define __IMPRO_LEACH_SENSORFIELD_H_
+
+#include <vector>
+#include <queue>
+#include <map>
+#include <unordered_map>
+#include <limits>
+#include <omnetpp.h>
+#include "common.h"
+#include "radio.h"
+#include "inbox.h"
+#include "philox.h"
+
+class BS;
+
+using namespace omnetpp;
+
+/**
+ * All the sensors of the network in one module (see Field_net).
+ * Node state is kept in arrays indexed by node id, and the LEACH logic of
+ * Sensor runs on an internal event queue ordered like the simulation FES
+ * (time, then scheduling order): the field only puts one wake-up event in
+ * the FES per distinct timestamp. Draws from the RNG happen in the same
+ * order as in Base_net, so the same seed gives the same network.
+ */
+class SensorField : public cSimpleModule
+{
+  private:
+    // internal events: the timers of a node (at most one pending per kind), then the messages it receives
+    enum fieldEvent {
+        F_START_ROUND,
+        F_RCVD_ADV,
+        F_RCVD_JOIN,
+        F_RCVD_DATA,
+        F_START_TX,
+        F_TIMERS,
+        F_ADV = F_TIMERS,   // ADV of node arg reaches all the alive sensors
+        F_JOIN,             // JOIN of node arg (round arg2) reaches the node
+        F_SCHED             // TDMA table arg (in tables) is on air
+    };
+
+    struct Event {
+        simtime_t t;
+        uint64_t seq;       // scheduling order, for events at the same time
+        int node;
+        int kind;
+        int arg, arg2;
+    };
+
+    struct Later {
+        bool operator()(const Event &a, const Event &b) const { return (a.t > b.t) || (a.t == b.t && a.seq > b.seq); }
+    };
+
+    struct Table {
+        double duration;    // TDMA slot duration
+        int round;
+        std::vector<int> members;   // in turn order
+    };
+
+    unsigned int N;         // nodes in the network
+    double P;               // proportion of CH in the network
+    bool electionEngine;    // CH election is drawn by the BS for the whole network
+    bool roundTick;         // rounds are started by the BS
+    bool counterRNG;        // election and placement draws come from crng
+    CounterRNG crng;
+    double roundTime;
+
+    double C = LIGHTSPEED;
+    double bitrate;         // bitrate of sensors
+    double range;           // max communication range of sensors
+    double Ecomp;
+    RadioModel radio;
+    RadioLink maxLink;
+
+    cModule *BS;
+    ::BS *BSstate;
+    std::vector<cModule *> sinks;   // the BS, then the extra sinks
+
+    // node state (SoA)
+    std::vector<int> x, y;
+    std::vector<double> energy;
+    std::vector<int> sink;              // nearest sink
+    std::vector<double> uplinkDist;     // distance paid by uplinks (see Sensor::locateSink)
+    std::vector<RadioLink> uplinkLink;  // amplifier cost towards the sink
+    std::vector<int> round;             // starts at -1, like Sensor's "round" parameter
+    std::vector<unsigned char> role;    // nodeRole
+    std::vector<bool> alreadyCH;
+    std::vector<int> CH_id;
+    std::vector<double> CH_dist;
+    std::vector<uint32_t> CHStamp[2];   // moves of the node and of its CH when CH_dist was computed (mobility)
+    std::vector<unsigned int> clusterN;
+    std::vector<uint64_t> timer[F_TIMERS];  // seq of the pending timer of each node (0: none)
+
+    std::unordered_map<int, MemberInbox> inbox;     // only for the nodes that got a JOIN this round
+    std::vector<Table> tables;
+    std::vector<int> freeTables;
+
+    std::priority_queue<Event, std::vector<Event>, Later> events;
+    uint64_t nextSeq;
+    std::map<simtime_t, cMessage *> wakes;  // FES event of each pending timestamp
+
+    void push(simtime_t t, int node, int kind, int arg = 0, int arg2 = 0);
+    void scheduleTimer(int n, int kind, simtime_t t);
+    void cancelTimer(int n, int kind) { timer[kind][n] = 0; }
+    void processEvent(const Event &e);
+
+  protected:
+    virtual void initialize();
+    virtual void finish();
+    virtual void handleMessage(cMessage *msg);
+
+    // LEACH logic, same as the Sensor functions of the same name
+    virtual double propagationDelay(unsigned int msg_size, double dist);
+    virtual void reset(int n);
+    virtual void selfElection(int n);
+    virtual void advertisementPhase(int n);
+    virtual void handleADV(int CH);
+    virtual void chooseCH(int n);
+    virtual void initOrphan(int n);
+    virtual void handleJoin(int n, int member, int r);
+    virtual void createTXSched(int n);
+    virtual void dispatchSchedule(int n, int t);
+    virtual void setupDataTX(int n, double duration, int r, unsigned int turn);
+    virtual void sendData(int n);
+    virtual void compressAndSendToBS(int n);
+    virtual void drainBattery(int n, double cost);
+    virtual void setAlreadyCH(int n, bool alreadyCH);
+    virtual void setCH(int n, int CH_id, double CH_dist);
+    virtual void locateSink(int n);
+    virtual void refreshCH(int n);
+
+  public:
+    virtual bool isAlive(int n) { return role[n] != DEAD; }
+    virtual int getRole(int n) { return role[n]; }
+    virtual int getCH(int n) { return CH_id[n]; }
+    virtual double getEnergy(int n) { return energy[n]; }
+    virtual int getX(int n) { return x[n]; }
+    virtual int getY(int n) { return y[n]; }
+    virtual void startRound(int n);
+    virtual void receiveSchedule(int n, mScheduleTable *SCHED, unsigned int turn);
+    virtual void moveTo(int n, int x, int y);
+    virtual void revive(int n, double battery, int round, simtime_t start);
+};
+
+#endif
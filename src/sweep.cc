@@ -0,0 +1,156 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <cmath>
+#include <limits>
+#include "sweep.h"
+#include "election.h"
+#include "common.h"
+
+#ifndef ONE_TX_PER_ROUND
+#error "SweepEngine models the one-transmission-per-round LEACH (ONE_TX_PER_ROUND)"
+#endif
+#ifdef ACCOUNT_CH_SETUP
+#error "SweepEngine does not account the setup messages (ACCOUNT_CH_SETUP)"
+#endif
+
+SweepEngine::SweepEngine() : N(0), V(0), Ecomp(0)
+{
+}
+
+void SweepEngine::setup(const std::vector<double> &P, const std::vector<int> &x, const std::vector<int> &y,
+        const std::vector<double> &energy, const RadioModel &radio, double range, double Ecomp)
+{
+    this->P = P;
+    this->x = x;
+    this->y = y;
+    this->radio = radio;
+    this->Ecomp = Ecomp;
+    N = x.size();
+    V = P.size();
+    uplinkLink = radio.link(MAX_DIST(range));
+    maxLink = radio.link(MAX_DIST(range));
+
+    epoch.resize(V);
+    for (unsigned int v = 0; v < V; v++)
+        epoch[v] = leachEpoch(P[v]);
+
+    this->energy.resize(N*V);
+    for (unsigned int n = 0; n < N; n++)
+        for (unsigned int v = 0; v < V; v++)
+            this->energy[n*V + v] = energy[n];
+    cost.assign(N*V, 0);
+    alreadyCH.assign(N*V, 0);
+    dead.assign(N*V, 0);
+    head.assign(N*V, 0);
+    members.assign(N, 0);
+
+    th.assign(V, 0);
+    alive.assign(V, N);
+    firstDead.assign(V, -1);
+    halfDead.assign(V, -1);
+    lastDead.assign(V, -1);
+}
+
+void SweepEngine::round(unsigned int r, const std::vector<double> &u)
+{
+    for (unsigned int v = 0; v < V; v++) {
+        if ((r % epoch[v]) == 0)
+            for (unsigned int n = 0; n < N; n++) alreadyCH[n*V + v] = 0;
+        th[v] = leachThreshold(P[v], r);
+    }
+
+    // election: the same draw against the threshold of every variant
+    for (unsigned int n = 0; n < N; n++) {
+        const double un = u[n];
+        uint8_t *h = &head[n*V], *already = &alreadyCH[n*V];
+        const uint8_t *d = &dead[n*V];
+        for (unsigned int v = 0; v < V; v++) {
+            h[v] = !d[v] & !already[v] & (un < th[v]);
+            already[v] |= h[v];
+        }
+    }
+
+    for (unsigned int v = 0; v < V; v++)
+        if (alive[v] > 0) cluster(v);
+
+    // energy update: a node dies when the cost of its round is more than it has left
+    for (unsigned int i = 0; i < N*V; i++) {
+        bool dies = !dead[i] && !(cost[i] < energy[i]);
+        energy[i] = (dead[i] || dies) ? energy[i] : energy[i] - cost[i];
+        cost[i] = 0;
+        if (dies) {
+            dead[i] = 1;
+            unsigned int v = i % V;
+            alive[v]--;
+            if (firstDead[v] < 0) firstDead[v] = r;
+            if (halfDead[v] < 0 && 2*alive[v] <= N) halfDead[v] = r;
+            if (alive[v] == 0) lastDead[v] = r;
+        }
+    }
+}
+
+void SweepEngine::cluster(unsigned int v)
+{
+    heads.clear();
+    for (unsigned int n = 0; n < N; n++)
+        if (head[n*V + v]) {
+            heads.push_back(n);
+            members[n] = 0;
+        }
+
+    // members: DATA to the nearest CH (ties go to the lowest id, the first ADV received)
+    for (unsigned int n = 0; n < N; n++) {
+        unsigned int i = n*V + v;
+        if (dead[i] || head[i]) continue;
+        double best = std::numeric_limits<double>::infinity();
+        int CH = -1;
+        for (unsigned int h = 0; h < heads.size(); h++) {
+            double dx = x[n] - ((double) x[heads[h]]);
+            double dy = y[n] - ((double) y[heads[h]]);
+            double dist = sqrt(dx*dx + dy*dy);
+            if (dist < best) {
+                best = dist;
+                CH = heads[h];
+            }
+        }
+        if (CH < 0)
+            cost[i] += radio.TX(DATA_M_SIZE, maxLink);    // orphan: straight to the BS
+        else {
+            cost[i] += radio.TX(DATA_M_SIZE, radio.link(best));
+            members[CH]++;
+        }
+    }
+
+    // CHs: aggregate to the BS, or act as orphans if nobody joined
+    for (unsigned int h = 0; h < heads.size(); h++) {
+        unsigned int i = heads[h]*V + v;
+#ifdef USE_BS_DIST
+        RadioLink uplinkLink = radio.link(BS_DIST(x[heads[h]], y[heads[h]]));
+#endif
+        if (members[heads[h]] > 0)
+            cost[i] += Ecomp * (members[heads[h]]*DATA_M_SIZE) + radio.TX(DATA_M_SIZE, uplinkLink);
+        else
+            cost[i] += radio.TX(DATA_M_SIZE, maxLink);
+    }
+}
+
+bool SweepEngine::over() const
+{
+    for (unsigned int v = 0; v < V; v++)
+        if (alive[v] > 0) return false;
+    return true;
+}
@@ -0,0 +1,78 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_SWEEP_H_
+#define __IMPRO_LEACH_SWEEP_H_
+
+#include <vector>
+#include <cstdint>
+#include "radio.h"
+
+/**
+ * Round-level model of one-TX-per-round LEACH, run for several values of P
+ * (variants) at once on the same deployment and the same random numbers.
+ * Per node state is stored variant-minor (index n*V + v), so the election
+ * and the energy update are plain loops over the variants of a node.
+ * Energy per round: every alive member sends one DATA to its nearest CH,
+ * every CH compresses and sends the aggregate to the BS, nodes without a
+ * cluster (and CHs without members) send their DATA to the BS.
+ */
+class SweepEngine
+{
+  private:
+    unsigned int N, V;
+    std::vector<double> P;
+    std::vector<unsigned int> epoch;
+    std::vector<int> x, y;
+    RadioModel radio;
+    RadioLink uplinkLink, maxLink;
+    double Ecomp;
+
+    // per node and variant (n*V + v)
+    std::vector<double> energy;
+    std::vector<double> cost;
+    std::vector<uint8_t> alreadyCH;
+    std::vector<uint8_t> dead;
+    std::vector<uint8_t> head;          // CH in the current round
+    std::vector<unsigned int> members;
+
+    // per variant
+    std::vector<double> th;
+    std::vector<unsigned int> alive;
+    std::vector<int> firstDead, halfDead, lastDead;
+    std::vector<int> heads;             // CHs of the variant being clustered
+
+    void cluster(unsigned int v);
+
+  public:
+    SweepEngine();
+    void setup(const std::vector<double> &P, const std::vector<int> &x, const std::vector<int> &y,
+            const std::vector<double> &energy, const RadioModel &radio, double range, double Ecomp);
+
+    /** Run round r of all the variants; u[n] is the election draw of node n (the same for all the variants). */
+    void round(unsigned int r, const std::vector<double> &u);
+    /** All the nodes of all the variants are dead. */
+    bool over() const;
+
+    unsigned int variants() const { return V; }
+    unsigned int getAlive(unsigned int v) const { return alive[v]; }
+    // round of the first death, of the death of half of the nodes, of the last death (-1: not yet)
+    int getFirstDead(unsigned int v) const { return firstDead[v]; }
+    int getHalfDead(unsigned int v) const { return halfDead[v]; }
+    int getLastDead(unsigned int v) const { return lastDead[v]; }
+};
+
+#endif
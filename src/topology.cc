@@ -0,0 +1,100 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "topology.h"
+
+static const char MAGIC[8] = {'L','E','A','C','H','T','P','1'};
+static const size_t HEADER = sizeof(MAGIC) + 4*sizeof(uint32_t);  // keeps the doubles 8-byte aligned
+
+Topology::Topology() : base(nullptr), length(0), N(0), edge(0), energy(false), xs(nullptr), ys(nullptr), es(nullptr)
+{
+}
+
+Topology::~Topology()
+{
+    if (base) munmap((void *) base, length);
+}
+
+bool Topology::map(const char *file)
+{
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < HEADER) {
+        close(fd);
+        return false;
+    }
+    length = st.st_size;
+    void *p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+    base = (const char *) p;
+
+    uint32_t flags;
+    memcpy(&N, base + sizeof(MAGIC), sizeof(N));
+    memcpy(&edge, base + sizeof(MAGIC) + 4, sizeof(edge));
+    memcpy(&flags, base + sizeof(MAGIC) + 8, sizeof(flags));
+    energy = flags & HAS_ENERGY;
+    size_t expected = HEADER + 2*sizeof(int32_t)*(size_t) N + (energy ? sizeof(double)*(size_t) N : 0);
+    if (memcmp(base, MAGIC, sizeof(MAGIC)) != 0 || length != expected)
+        return false;
+
+    xs = (const int32_t *) (base + HEADER);
+    ys = xs + N;
+    es = energy ? (const double *) (base + HEADER + 2*sizeof(int32_t)*(size_t) N) : nullptr;
+    return true;
+}
+
+const Topology *Topology::get(const std::string &file)
+{
+    // read-only and shared by all the modules (and all the runs) of the process
+    static std::map<std::string, Topology *> mapped;
+    std::map<std::string, Topology *>::iterator it = mapped.find(file);
+    if (it != mapped.end()) return it->second;
+
+    Topology *topology = new Topology();
+    if (!topology->map(file.c_str())) {
+        delete topology;
+        return nullptr;
+    }
+    mapped[file] = topology;
+    return topology;
+}
+
+bool Topology::write(const char *file, int edge, const std::vector<int> &x, const std::vector<int> &y, const std::vector<double> &energy)
+{
+    FILE *f = fopen(file, "wb");
+    if (!f) return false;
+    uint32_t N = x.size(), flags = energy.empty() ? 0 : HAS_ENERGY, reserved = 0;
+    int32_t e = edge;
+    bool ok = fwrite(MAGIC, sizeof(MAGIC), 1, f) == 1 && fwrite(&N, sizeof(N), 1, f) == 1
+            && fwrite(&e, sizeof(e), 1, f) == 1 && fwrite(&flags, sizeof(flags), 1, f) == 1
+            && fwrite(&reserved, sizeof(reserved), 1, f) == 1;
+    std::vector<int32_t> coord(x.begin(), x.end());
+    ok = ok && (N == 0 || fwrite(coord.data(), sizeof(int32_t), N, f) == N);
+    coord.assign(y.begin(), y.end());
+    ok = ok && (N == 0 || fwrite(coord.data(), sizeof(int32_t), N, f) == N);
+    if (flags & HAS_ENERGY)
+        ok = ok && fwrite(energy.data(), sizeof(double), N, f) == N;
+    return (fclose(f) == 0) && ok;
+}
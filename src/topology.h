@@ -0,0 +1,65 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#ifndef __IMPRO_LEACH_TOPOLOGY_H_
+#define __IMPRO_LEACH_TOPOLOGY_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Deployment file: the positions (and optionally the initial energy) of the
+ * nodes of a network, so that several configurations run on the same nodes.
+ * Binary layout, native byte order:
+ *   char magic[8] = "LEACHTP1"; uint32 N; int32 edge; uint32 flags (1: energy); uint32 reserved;
+ *   int32 x[N]; int32 y[N]; then, with flag 1, double energy[N].
+ * Files are memory-mapped read-only, once per process (see get()).
+ */
+class Topology
+{
+  private:
+    const char *base;
+    size_t length;
+    uint32_t N;
+    int32_t edge;
+    bool energy;
+    const int32_t *xs, *ys;
+    const double *es;
+
+    Topology();
+    Topology(const Topology &);
+    ~Topology();
+    bool map(const char *file);
+
+  public:
+    enum { HAS_ENERGY = 1 };
+
+    /** Mapping of file (shared by all the modules); nullptr if it can't be read or is not a topology. */
+    static const Topology *get(const std::string &file);
+    /** Write a topology file (energy may be empty); returns false on I/O errors. */
+    static bool write(const char *file, int edge, const std::vector<int> &x, const std::vector<int> &y, const std::vector<double> &energy);
+
+    unsigned int size() const { return N; }
+    int getEdge() const { return edge; }
+    bool hasEnergy() const { return energy; }
+    int x(unsigned int n) const { return xs[n]; }
+    int y(unsigned int n) const { return ys[n]; }
+    double getEnergy(unsigned int n) const { return es[n]; }
+};
+
+#endif
@@ -0,0 +1,77 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+#include <cstdio>
+#include <cstring>
+#include "trace.h"
+
+static const char MAGIC[8] = {'L','E','A','C','H','T','R','1'};
+
+void TraceRing::setup(unsigned int records)
+{
+    uint64_t size = 0;
+    if (records > 0)
+        for (size = 1; size < records; size <<= 1) ;
+    slots.assign(size, TraceRecord());
+    mask = size ? size-1 : 0;
+    next.store(0);
+}
+
+bool TraceRing::dump(const char *file, int scaleExp) const
+{
+    FILE *f = fopen(file, "wb");
+    if (!f) return false;
+    uint64_t n = next.load(std::memory_order_acquire);
+    uint64_t count = (n < slots.size()) ? n : slots.size();
+    uint64_t lost = n - count;
+    int32_t exp = scaleExp;
+    uint32_t recordSize = sizeof(TraceRecord);
+    bool ok = fwrite(MAGIC, sizeof(MAGIC), 1, f) == 1 && fwrite(&exp, sizeof(exp), 1, f) == 1
+            && fwrite(&recordSize, sizeof(recordSize), 1, f) == 1 && fwrite(&count, sizeof(count), 1, f) == 1
+            && fwrite(&lost, sizeof(lost), 1, f) == 1;
+    // oldest first: the ring may have wrapped around
+    for (uint64_t i = lost; ok && i < n; i++)
+        ok = fwrite(&slots[i & mask], sizeof(TraceRecord), 1, f) == 1;
+    return (fclose(f) == 0) && ok;
+}
+
+bool TraceRing::load(const char *file, int &scaleExp, uint64_t &lost, std::vector<TraceRecord> &records)
+{
+    FILE *f = fopen(file, "rb");
+    if (!f) return false;
+    char magic[8];
+    int32_t exp = 0;
+    uint32_t recordSize;
+    uint64_t count;
+    bool ok = fread(magic, sizeof(magic), 1, f) == 1 && fread(&exp, sizeof(exp), 1, f) == 1
+            && fread(&recordSize, sizeof(recordSize), 1, f) == 1 && fread(&count, sizeof(count), 1, f) == 1
+            && fread(&lost, sizeof(lost), 1, f) == 1
+            && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 && recordSize == sizeof(TraceRecord);
+    if (ok) {
+        records.resize(count);
+        ok = count == 0 || fread(records.data(), sizeof(TraceRecord), count, f) == count;
+    }
+    scaleExp = exp;
+    fclose(f);
+    return ok;
+}
+
+const char *TraceRing::kindName(int kind)
+{
+    static const char *names[KINDS] = {"round", "election", "join", "sched", "data", "death", "center", "anomaly", "battery"};
+    return (kind >= 0 && kind < KINDS) ? names[kind] : "?";
+}
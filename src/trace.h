@@ -0,0 +1,93 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+#ifndef __IMPRO_LEACH_TRACE_H_
+#define __IMPRO_LEACH_TRACE_H_
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+/**
+ * Fixed-size binary trace of the protocol events of a network: the last
+ * records are kept in a ring (lock-free, writers only bump an atomic index),
+ * and go to disk only when dump() is called. Decode the files with
+ * tools/tracedump. Binary layout, native byte order:
+ *   char magic[8] = "LEACHTR1"; int32 scaleExp; uint32 recordSize;
+ *   uint64 count; uint64 lost (older records overwritten); TraceRecord[count], oldest first.
+ */
+struct TraceRecord
+{
+    int64_t t;          // raw simulation time (see scaleExp)
+    int32_t round;
+    int32_t node;
+    int32_t arg;        // kind dependent, see TraceRing::kind
+    uint16_t kind;
+    uint16_t reserved;
+};
+
+class TraceRing
+{
+  private:
+    std::vector<TraceRecord> slots;
+    uint64_t mask;
+    std::atomic<uint64_t> next;     // records written so far
+
+  public:
+    enum kind {
+        ROUND,      // the BS starts a round (node -1)
+        ELECTION,   // node is CH (arg: 1 self-elected, 0 assigned by the BS)
+        JOIN,       // node joins the cluster of CH arg
+        SCHED,      // CH node puts on air the TDMA table of arg members
+        DATA,       // node sends its data to arg (CH, or the BS)
+        DEATH,      // node ran out of energy
+        CENTER,     // CH node hands the cluster over to arg (CENTER_M)
+        ANOMALY,    // something unexpected seen by node, see TraceRing::anomaly
+        BATTERY,    // node gets a new battery (arg: 1 if it comes back or is deployed, 0 if it was alive)
+        KINDS
+    };
+    enum anomaly {
+        STALE_DATA,     // DATA of an older round at the BS
+        STALE_SCHED     // TDMA table of another round at a node
+    };
+
+    TraceRing() : mask(0), next(0) {}
+    /** Keep the last records (rounded up to a power of two; 0 disables the trace). */
+    void setup(unsigned int records);
+    bool isEnabled() const { return !slots.empty(); }
+
+    void record(int64_t t, int kind, int round, int node, int arg)
+    {
+        uint64_t i = next.fetch_add(1, std::memory_order_relaxed);
+        TraceRecord &rec = slots[i & mask];
+        rec.t = t;
+        rec.round = round;
+        rec.node = node;
+        rec.arg = arg;
+        rec.kind = kind;
+        rec.reserved = 0;
+    }
+
+    uint64_t getRecorded() const { return next.load(std::memory_order_relaxed); }
+    /** Write the records in the ring, oldest first; returns false on I/O errors. */
+    bool dump(const char *file, int scaleExp) const;
+    /** Read a file written by dump(); returns false if it can't be read or is not a trace. */
+    static bool load(const char *file, int &scaleExp, uint64_t &lost, std::vector<TraceRecord> &records);
+    static const char *kindName(int kind);
+};
+
+#endif
@@ -0,0 +1,122 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+// Compares two digest files written by the BS (see the digestFile parameter)
+// and reports the first round boundary, and node, where the runs diverge.
+// With -e epoch, the runs only need the same statistics (e.g. electionEngine
+// on and off): compares the mean number of CHs at each round of the LEACH
+// epoch (1/P rounds) instead, and reports the positions that differ by more
+// than the larger of 0.5 CHs and 15%.
+// Exit status: 0 same runs, 1 different runs, 2 errors.
+//
+//   digestdiff [-e epoch] reference other
+
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include "digest.h"
+
+static int usage()
+{
+    fprintf(stderr, "usage: digestdiff [-e epoch] reference other\n");
+    return 2;
+}
+
+// mean CHs of the rounds at each position of the epoch
+static void meanHeads(FILE *f, unsigned int epoch, std::vector<double> &mean)
+{
+    std::vector<unsigned long> rounds(epoch, 0);
+    mean.assign(epoch, 0);
+    StateDigest::Round r;
+    while (StateDigest::read(f, r)) {
+        if (r.round <= 0) continue; // no round over yet
+        unsigned int k = (r.round - 1) % epoch;
+        mean[k] += r.heads;
+        rounds[k]++;
+    }
+    for (unsigned int k = 0; k < epoch; k++)
+        if (rounds[k]) mean[k] /= rounds[k];
+}
+
+static int compareHeads(FILE *f[2], unsigned int epoch)
+{
+    std::vector<double> a, b;
+    meanHeads(f[0], epoch, a);
+    meanHeads(f[1], epoch, b);
+    int different = 0;
+    for (unsigned int k = 0; k < epoch; k++)
+        if (fabs(a[k] - b[k]) > std::max(0.5, 0.15 * a[k])) {
+            printf("%sround %u of the epoch: %.2f CHs vs %.2f", different ? ", " : "", k, a[k], b[k]);
+            different = 1;
+        }
+    if (different)
+        printf("\n");
+    else
+        printf("same CHs per round of the epoch (%u rounds)\n", epoch);
+    return different;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int epoch = 0;
+    if (argc == 5 && !strcmp(argv[1], "-e")) {
+        epoch = atoi(argv[2]);
+        if (epoch == 0) return usage();
+        argv += 2;
+        argc -= 2;
+    }
+    if (argc != 3) return usage();
+    FILE *f[2];
+    for (int i = 0; i < 2; i++)
+        if (!(f[i] = fopen(argv[i+1], "r"))) {
+            fprintf(stderr, "digestdiff: can't read %s\n", argv[i+1]);
+            return 2;
+        }
+    if (epoch) return compareHeads(f, epoch);
+
+    StateDigest::Round a, b;
+    unsigned int rounds = 0;
+    for (;;) {
+        bool moreA = StateDigest::read(f[0], a), moreB = StateDigest::read(f[1], b);
+        if (!moreA && !moreB) break;
+        if (moreA != moreB) {
+            printf("%s ends before round %d, %s goes on\n", argv[moreA ? 2 : 1], (moreA ? a : b).round, argv[moreA ? 1 : 2]);
+            return 1;
+        }
+        if (a.round != b.round || a.nodes.size() != b.nodes.size()) {
+            printf("not the same network: round %d with %d nodes vs round %d with %d nodes\n",
+                    a.round, (int) a.nodes.size(), b.round, (int) b.nodes.size());
+            return 1;
+        }
+        if (a.network != b.network) {
+            printf("diverge at round %d: Ndead %u vs %u", a.round, a.Ndead, b.Ndead);
+            for (unsigned int n = 0; n < a.nodes.size(); n++)
+                if (a.nodes[n] != b.nodes[n]) {
+                    printf(", first different node %u", n);
+                    break;
+                }
+            printf("\n");
+            return 1;
+        }
+        rounds++;
+    }
+    printf("same %u rounds\n", rounds);
+    return 0;
+}
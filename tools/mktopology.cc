@@ -0,0 +1,88 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+// Writes a deployment file for the topologyFile parameter of Base_net:
+// Nnodes distinct random positions in [minX,edge]x[minY,edge] (never (0,0),
+// like Sensor::initialize()), optionally with the initial energy of each node.
+//
+//   mktopology -n Nnodes -e edge [-x minX] [-y minY] [-s seed]
+//              [-E energy | -U min max] -o file
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+#include "topology.h"
+
+static void usage()
+{
+    fprintf(stderr, "usage: mktopology -n Nnodes -e edge [-x minX] [-y minY] [-s seed] [-E energy | -U min max] -o file\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    int N = -1, edge = -1, minX = 0, minY = 0;
+    unsigned long seed = 1;
+    double Emin = -1, Emax = -1;
+    const char *file = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool more = i+1 < argc;
+        if (!strcmp(argv[i], "-n") && more) N = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-e") && more) edge = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-x") && more) minX = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-y") && more) minY = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && more) seed = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "-E") && more) Emin = Emax = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-U") && i+2 < argc) { Emin = atof(argv[++i]); Emax = atof(argv[++i]); }
+        else if (!strcmp(argv[i], "-o") && more) file = argv[++i];
+        else usage();
+    }
+    if (N < 0 || edge < 0 || !file || minX > edge || minY > edge || Emin > Emax) usage();
+    if ((double) N > ((double) edge - minX + 1) * ((double) edge - minY + 1) - 1) {
+        fprintf(stderr, "mktopology: %d nodes don't fit in the area\n", N);
+        return 1;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> ux(minX, edge), uy(minY, edge);
+    std::set<std::pair<int,int> > taken;
+    taken.insert(std::make_pair(0, 0));
+    std::vector<int> x(N), y(N);
+    for (int n = 0; n < N; n++) {
+        do {
+            x[n] = ux(rng);
+            y[n] = uy(rng);
+        } while (taken.count(std::make_pair(x[n], y[n])));
+        taken.insert(std::make_pair(x[n], y[n]));
+    }
+
+    std::vector<double> energy;
+    if (Emin >= 0) {
+        std::uniform_real_distribution<double> ue(Emin, Emax);
+        for (int n = 0; n < N; n++)
+            energy.push_back(Emin == Emax ? Emin : ue(rng));
+    }
+
+    if (!Topology::write(file, edge, x, y, energy)) {
+        fprintf(stderr, "mktopology: can't write %s\n", file);
+        return 1;
+    }
+    return 0;
+}
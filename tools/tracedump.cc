@@ -0,0 +1,90 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+
+// Renders a trace written by the BS (see the traceRecords parameter) as text,
+// or as CSV with -c; -k keeps only the events of one kind, -n of one node.
+//
+//   tracedump [-c] [-k kind] [-n node] file
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include "trace.h"
+
+#define BS_ID 999999    // as in src/common.h
+
+static void usage()
+{
+    fprintf(stderr, "usage: tracedump [-c] [-k kind] [-n node] file\n");
+    exit(1);
+}
+
+static const char *nodeName(int node, char *buf)
+{
+    if (node == BS_ID) return "BS";
+    sprintf(buf, "%d", node);
+    return buf;
+}
+
+int main(int argc, char **argv)
+{
+    bool csv = false;
+    int kind = -1;
+    long node = -2;     // -1 is the BS starting a round
+    const char *file = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool more = i+1 < argc;
+        if (!strcmp(argv[i], "-c")) csv = true;
+        else if (!strcmp(argv[i], "-k") && more) {
+            const char *name = argv[++i];
+            for (kind = 0; kind < TraceRing::KINDS && strcmp(name, TraceRing::kindName(kind)); kind++) ;
+            if (kind == TraceRing::KINDS) usage();
+        }
+        else if (!strcmp(argv[i], "-n") && more) node = atol(argv[++i]);
+        else if (argv[i][0] != '-' && !file) file = argv[i];
+        else usage();
+    }
+    if (!file) usage();
+
+    int scaleExp;
+    uint64_t lost;
+    std::vector<TraceRecord> records;
+    if (!TraceRing::load(file, scaleExp, lost, records)) {
+        fprintf(stderr, "tracedump: %s is not a trace file\n", file);
+        return 1;
+    }
+
+    double scale = pow(10.0, scaleExp);
+    if (csv)
+        printf("time,round,event,node,arg\n");
+    else if (lost > 0)
+        printf("(%llu older events lost)\n", (unsigned long long) lost);
+    for (size_t i = 0; i < records.size(); i++) {
+        const TraceRecord &rec = records[i];
+        if ((kind >= 0 && rec.kind != kind) || (node != -2 && rec.node != node)) continue;
+        char a[16], b[16];
+        if (csv)
+            printf("%.12g,%d,%s,%d,%d\n", rec.t*scale, rec.round, TraceRing::kindName(rec.kind), rec.node, rec.arg);
+        else
+            printf("%14.9f  round %-5d %-8s node %-6s arg %s\n", rec.t*scale, rec.round,
+                    TraceRing::kindName(rec.kind), nodeName(rec.node, a), nodeName(rec.arg, b));
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#!/bin/sh
+#
+# Differential validation: runs every config of a matrix with the same seed in
+# its reference mode (Base_net, default flags) and in the execution modes that
+# must give the same simulation, then compares their per-round state digests
+# (see the digestFile parameter of BS, and tools/digestdiff).
+#
+#   tools/validate.sh [-r runs] [config:mode,mode ...]
+#
+# Modes: field (Field_net), tick (roundTick), buckets (phaseBuckets),
+# ledger (energyLedger). Field_net only runs the plain LEACH strategy, and
+# draws the initial energies in another order than the sensor modules: not
+# with a random energy (BaseLeachUniform). phaseBuckets may reorder events at
+# the same time, so buckets is not in the default matrix.
+# engine (electionEngine) draws the CHs in another way: it only has to give
+# the same CHs per round of the epoch (EPOCH rounds, 1/P; digestdiff -e).
+# Needs the simulation binary (make, or BIN=...) and the tools (make tools).
+
+set -f    # the options are patterns, not files
+cd `dirname $0`/..
+ROOT=`pwd`
+BIN=${BIN:-$ROOT/src/impro-leach}
+RUNS=0
+if [ "$1" = "-r" ]; then RUNS=$2; shift 2; fi
+MATRIX=${*:-"BaseLeach:field,tick,ledger BaseLeachClusterCenter:tick,ledger \
+BaseLeachEnergy:tick,ledger BaseLeachClusterCenterEnergy:tick,ledger \
+BaseLeachUniform:tick,ledger Direct-tx:field,tick MaintainedLeach:engine"}
+EPOCH=${EPOCH:-20}
+OUT=$ROOT/out/validate
+mkdir -p $OUT
+
+run() {
+    # run config $1 (run number $2) writing digest $3, with more options
+    config=$1 run=$2 digest=$3
+    shift 3
+    (cd simulations && $BIN -u Cmdenv -n .:../src -f base_net.ini -c $config -r $run \
+        --cmdenv-express-mode=true --result-dir=$OUT/results --record-eventlog=false \
+        --**.vector-recording=false "--*.baseStation.digestFile=\"$digest\"" "$@" >$OUT/log 2>&1) \
+        || { echo "$config run $run: simulation failed, see $OUT/log"; exit 2; }
+}
+
+failed=0
+for entry in $MATRIX; do
+    config=${entry%%:*}
+    modes=`echo ${entry#*:} | tr ',' ' '`
+    for r in `seq 0 $RUNS`; do
+        ref=$OUT/$config-$r-ref.txt
+        run $config $r $ref
+        for mode in $modes; do
+            diff="$ROOT/tools/digestdiff"
+            case $mode in
+                engine)  opts="--*.electionEngine=true"; diff="$diff -e $EPOCH" ;;
+                field)   opts="--network=impro_leach.simulations.Field_net --*.field.bitrate=100000" ;;
+                tick)    opts="--*.roundTick=true" ;;
+                buckets) opts="--*.phaseBuckets=true" ;;
+                ledger)  opts="--*.energyLedger=true" ;;
+                *) echo "unknown mode $mode"; exit 2 ;;
+            esac
+            digest=$OUT/$config-$r-$mode.txt
+            run $config $r $digest $opts
+            printf "%s run %s %s: " $config $r $mode
+            $diff $ref $digest || failed=1
+        done
+    done
+done
+exit $failed